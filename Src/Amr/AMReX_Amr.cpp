@@ -79,9 +79,11 @@ namespace
     int  probinit_natonce;
 #endif
     bool plot_files_output;
+    bool plot_batch_derive;
     int  checkpoint_nfiles;
     int  regrid_on_restart;
     int  use_efficient_regrid;
+    int  regrid_prefetch;
     int  plotfile_on_restart;
     int  insitu_on_restart;
     int  checkpoint_on_restart;
@@ -115,9 +117,11 @@ Amr::Initialize ()
     probinit_natonce         = 512;
 #endif
     plot_files_output        = true;
+    plot_batch_derive        = false;
     checkpoint_nfiles        = 64;
     regrid_on_restart        = 0;
     use_efficient_regrid     = 0;
+    regrid_prefetch          = 0;
     plotfile_on_restart      = 0;
     insitu_on_restart        = 0;
     checkpoint_on_restart    = 0;
@@ -150,6 +154,8 @@ Amr::Finalize ()
 
 bool Amr::Plot_Files_Output () { return plot_files_output; }
 
+bool Amr::Plot_Batch_Derive () { return plot_batch_derive; }
+
 std::ostream&
 Amr::DataLog (int i)
 {
@@ -258,6 +264,7 @@ Amr::InitAmr ()
     //
     pp.query("regrid_on_restart",regrid_on_restart);
     pp.query("use_efficient_regrid",use_efficient_regrid);
+    pp.query("regrid_prefetch",regrid_prefetch);
     pp.query("plotfile_on_restart",plotfile_on_restart);
     pp.query("insitu_on_restart",insitu_on_restart);
     pp.query("checkpoint_on_restart",checkpoint_on_restart);
@@ -331,6 +338,8 @@ Amr::InitAmr ()
     n_cycle.resize(nlev);
     dt_min.resize(nlev);
     amr_level.resize(nlev);
+    level_time.resize(nlev, 0.0);
+    level_time_count.resize(nlev, 0);
     //
     // Set bogus values.
     //
@@ -1514,6 +1523,11 @@ Amr::restart (const std::string& filename)
        Vector<int>  n_cycle_in;
        n_cycle_in.resize(mx_lev+1);
        for (int i(0); i <= mx_lev; ++i) { is >> n_cycle_in[i]; }
+       if (subcycling_mode == "Adaptive")
+       {
+           // n_cycle was chosen at run time, so we keep it.
+           for (int i(0); i <= std::min(mx_lev,max_level); ++i) { n_cycle[i] = n_cycle_in[i]; }
+       }
        bool any_changed = false;
 
        for (int i(0); i <= mx_lev; ++i) {
@@ -1771,6 +1785,14 @@ Amr::checkPoint ()
 
     HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
 
+    //
+    // With AsyncOut, the header is built in memory and written by the
+    // background thread after the data that were submitted before it.
+    //
+    std::ostringstream HeaderStream;
+    std::ostream& HeaderOS = (AsyncOut::UseAsyncOut())
+        ? static_cast<std::ostream&>(HeaderStream) : static_cast<std::ostream&>(HeaderFile);
+
     int old_prec = 0;
 
     if (ParallelDescriptor::IOProcessor())
@@ -1778,16 +1800,18 @@ Amr::checkPoint ()
         //
         // Only the IOProcessor() writes to the header file.
         //
-        HeaderFile.open(HeaderFileName.c_str(), std::ios::out | std::ios::trunc |
-                                                std::ios::binary);
+        if ( ! AsyncOut::UseAsyncOut()) {
+            HeaderFile.open(HeaderFileName.c_str(), std::ios::out | std::ios::trunc |
+                                                    std::ios::binary);
 
-        if ( ! HeaderFile.good()) {
-            amrex::FileOpenFailed(HeaderFileName);
+            if ( ! HeaderFile.good()) {
+                amrex::FileOpenFailed(HeaderFileName);
+            }
         }
 
-        old_prec = HeaderFile.precision(17);
+        old_prec = HeaderOS.precision(17);
 
-        HeaderFile << CheckPointVersion << '\n'
+        HeaderOS << CheckPointVersion << '\n'
                    << AMREX_SPACEDIM       << '\n'
                    << cumtime           << '\n'
                    << max_level         << '\n'
@@ -1795,55 +1819,76 @@ Amr::checkPoint ()
         //
         // Write out problem domain.
         //
-        for (int i(0); i <= max_level; ++i) { HeaderFile << Geom(i)        << ' '; }
-        HeaderFile << '\n';
-        for (int i(0); i < max_level; ++i)  { HeaderFile << ref_ratio[i]   << ' '; }
-        HeaderFile << '\n';
-        for (int i(0); i <= max_level; ++i) { HeaderFile << dt_level[i]    << ' '; }
-        HeaderFile << '\n';
-        for (int i(0); i <= max_level; ++i) { HeaderFile << dt_min[i]      << ' '; }
-        HeaderFile << '\n';
-        for (int i(0); i <= max_level; ++i) { HeaderFile << n_cycle[i]     << ' '; }
-        HeaderFile << '\n';
-        for (int i(0); i <= max_level; ++i) { HeaderFile << level_steps[i] << ' '; }
-        HeaderFile << '\n';
-        for (int i(0); i <= max_level; ++i) { HeaderFile << level_count[i] << ' '; }
-        HeaderFile << '\n';
+        for (int i(0); i <= max_level; ++i) { HeaderOS << Geom(i)        << ' '; }
+        HeaderOS << '\n';
+        for (int i(0); i < max_level; ++i)  { HeaderOS << ref_ratio[i]   << ' '; }
+        HeaderOS << '\n';
+        for (int i(0); i <= max_level; ++i) { HeaderOS << dt_level[i]    << ' '; }
+        HeaderOS << '\n';
+        for (int i(0); i <= max_level; ++i) { HeaderOS << dt_min[i]      << ' '; }
+        HeaderOS << '\n';
+        for (int i(0); i <= max_level; ++i) { HeaderOS << n_cycle[i]     << ' '; }
+        HeaderOS << '\n';
+        for (int i(0); i <= max_level; ++i) { HeaderOS << level_steps[i] << ' '; }
+        HeaderOS << '\n';
+        for (int i(0); i <= max_level; ++i) { HeaderOS << level_count[i] << ' '; }
+        HeaderOS << '\n';
     }
 
     for (int i = 0; i <= finest_level; ++i) {
-        amr_level[i]->checkPointPre(ckfileTemp, HeaderFile);
+        amr_level[i]->checkPointPre(ckfileTemp, HeaderOS);
     }
 
     for (int i = 0; i <= finest_level; ++i) {
-        amr_level[i]->checkPoint(ckfileTemp, HeaderFile);
+        amr_level[i]->checkPoint(ckfileTemp, HeaderOS);
     }
 
     for (int i = 0; i <= finest_level; ++i) {
-        amr_level[i]->checkPointPost(ckfileTemp, HeaderFile);
+        amr_level[i]->checkPointPost(ckfileTemp, HeaderOS);
     }
 
     if (ParallelDescriptor::IOProcessor()) {
         const Vector<std::string> &FAHeaderNames = StateData::FabArrayHeaderNames();
-        if(FAHeaderNames.size() > 0) {
-            std::string FAHeaderFilesName = ckfileTemp + "/FabArrayHeaders.txt";
-            std::ofstream FAHeaderFile(FAHeaderFilesName.c_str(),
-                                       std::ios::out | std::ios::trunc |
-                                       std::ios::binary);
-            if ( ! FAHeaderFile.good()) {
-                amrex::FileOpenFailed(FAHeaderFilesName);
+        auto write_headers = [=, header = HeaderStream.str()] ()
+        {
+            if (AsyncOut::UseAsyncOut()) {
+                std::ofstream ofs(HeaderFileName.c_str(), std::ios::out | std::ios::trunc |
+                                                          std::ios::binary);
+                if ( ! ofs.good()) {
+                    amrex::FileOpenFailed(HeaderFileName);
+                }
+                ofs << header;
+                if ( ! ofs.good()) {
+                    amrex::Error("Amr::checkpoint() failed");
+                }
             }
 
-            for(int i(0); i < FAHeaderNames.size(); ++i) {
-                FAHeaderFile << FAHeaderNames[i] << '\n';
+            if(FAHeaderNames.size() > 0) {
+                std::string FAHeaderFilesName = ckfileTemp + "/FabArrayHeaders.txt";
+                std::ofstream FAHeaderFile(FAHeaderFilesName.c_str(),
+                                           std::ios::out | std::ios::trunc |
+                                           std::ios::binary);
+                if ( ! FAHeaderFile.good()) {
+                    amrex::FileOpenFailed(FAHeaderFilesName);
+                }
+
+                for(int i(0); i < FAHeaderNames.size(); ++i) {
+                    FAHeaderFile << FAHeaderNames[i] << '\n';
+                }
             }
+        };
+
+        if (AsyncOut::UseAsyncOut()) {
+            AsyncOut::Submit(std::move(write_headers));
+        } else {
+            write_headers();
         }
     }
 
     if(ParallelDescriptor::IOProcessor()) {
-        HeaderFile.precision(old_prec);
+        HeaderOS.precision(old_prec);
 
-        if( ! HeaderFile.good()) {
+        if( ! HeaderOS.good()) {
             amrex::Error("Amr::checkpoint() failed");
         }
     }
@@ -1923,6 +1968,9 @@ Amr::timeStep (int  level,
     BL_PROFILE("Amr::timeStep()");
     BL_COMM_PROFILE_NAMETAG("Amr::timeStep TOP");
 
+    const double time_start = amrex::second();
+    double time_finer = 0.0;
+
     // This is used so that the AmrLevel functions can know which level is being advanced
     //      when regridding is called with possible lbase > level.
     which_level_being_advanced = level;
@@ -2052,6 +2100,7 @@ Amr::timeStep (int  level,
     if (level < finest_level)
     {
         const int lev_fine = level+1;
+        const double time_finer_start = amrex::second();
 
         if (sub_cycle)
         {
@@ -2066,10 +2115,15 @@ Amr::timeStep (int  level,
             BL_COMM_PROFILE_NAMETAG("Amr::timeStep timeStep nosubcycle");
             timeStep(lev_fine,time,1,1,stop_time);
         }
+
+        time_finer = amrex::second() - time_finer_start;
     }
 
     amr_level[level]->post_timestep(iteration);
 
+    level_time[level] += amrex::second() - time_start - time_finer;
+    level_time_count[level]++;
+
     // Set this back to negative so we know whether we are in fact in this routine
     which_level_being_advanced = -1;
 }
@@ -2093,6 +2147,12 @@ Amr::coarseTimeStep (Real stop_time)
 
     run_strt = amrex::second() ;
 
+    if (subcycling_mode == "Adaptive" && levelSteps(0) > 0 &&
+        levelSteps(0) % subcycling_adapt_int == 0)
+    {
+        adaptSubcycling();
+    }
+
     //
     // Compute new dt.
     //
@@ -2126,6 +2186,8 @@ Amr::coarseTimeStep (Real stop_time)
 
     amr_level[0]->postCoarseTimeStep(cumtime);
 
+    coarse_step_time += amrex::second() - run_strt;
+    coarse_step_count++;
 
     if (verbose > 0)
     {
@@ -2605,6 +2667,23 @@ Amr::regrid (int  lbase,
 
     finest_level = new_finest;
 
+    //
+    // Start moving the data of the old levels to the new grids.  The
+    // communication for all the levels is then in flight while the new
+    // levels are initialized one after another below.
+    //
+    if (!initial && regrid_prefetch && !loadbalance_with_workestimates)
+    {
+        for (int lev = start; lev <= new_finest; ++lev) {
+            if (new_dmap[lev].empty()) {
+                new_dmap[lev].define(new_grid_places[lev]);
+            }
+            if (amr_level[lev]) {
+                amr_level[lev]->prefetchNewData(new_grid_places[lev], new_dmap[lev]);
+            }
+        }
+    }
+
     //
     // Define the new grids from level start up to new_finest.
     //
@@ -3164,6 +3243,19 @@ Amr::initSubcycle ()
             n_cycle[i] = MaxRefRatio(i-1);
         }
     }
+    else if (subcycling_mode == "Adaptive")
+    {
+        // n_cycle is re-evaluated every subcycling_adapt_int coarse steps
+        // from the measured cost of the levels.  We start with Auto.
+        n_cycle[0] = 1;
+        for (int i = 1; i <= max_level; i++)
+        {
+            n_cycle[i] = MaxRefRatio(i-1);
+        }
+        pp.query("subcycling_adapt_int",subcycling_adapt_int);
+        if (subcycling_adapt_int <= 0)
+            amrex::Error("subcycling_adapt_int must be > 0");
+    }
     else
     {
         std::string err_message = "Unrecognzied subcycling mode: " + subcycling_mode + "\n";
@@ -3178,6 +3270,7 @@ Amr::initPltAndChk ()
 
     pp.query("checkpoint_files_output", checkpoint_files_output);
     pp.query("plot_files_output", plot_files_output);
+    pp.query("plot_batch_derive", plot_batch_derive);
 
     pp.query("plot_nfiles", plot_nfiles);
     pp.query("checkpoint_nfiles", checkpoint_nfiles);
@@ -3272,6 +3365,91 @@ Amr::okToRegrid(int level) noexcept
         return level_count[level] >= regrid_int[level] && amr_level[level]->okToRegrid();
 }
 
+void
+Amr::adaptSubcycling ()
+{
+    BL_PROFILE("Amr::adaptSubcycling()");
+
+    const int nlevs = finest_level+1;
+
+    // The cost of a step at each level, and of a coarse step, measured
+    // since the last re-evaluation.  The slowest process sets the pace.
+    Vector<Real> cost(nlevs+1);
+    for (int lev = 0; lev < nlevs; ++lev) {
+        cost[lev] = (level_time_count[lev] > 0) ? level_time[lev]/level_time_count[lev] : -1.0;
+    }
+    cost[nlevs] = (coarse_step_count > 0) ? coarse_step_time/coarse_step_count : 0.0;
+    ParallelDescriptor::ReduceRealMax(cost.data(), nlevs+1);
+    const Real realized = cost[nlevs];
+    cost.resize(nlevs);
+
+    // Levels created since the last re-evaluation have not been measured.
+    bool measured = true;
+    for (int lev = 0; lev < nlevs; ++lev) {
+        measured = measured && cost[lev] > 0.0;
+    }
+
+    if (nlevs > 1 && measured)
+    {
+        // The CFL constraints are the time steps estimated by the
+        // advances of the last coarse step.
+        Vector<int> best(nlevs), cycle_max(nlevs);
+        Vector<Real> dt_max(nlevs);
+        cycle_max[0] = 1;
+        dt_max[0] = dt_min[0];
+        for (int lev = 1; lev < nlevs; ++lev) {
+            cycle_max[lev] = MaxRefRatio(lev-1);
+            dt_max[lev] = dt_min[lev];
+        }
+        computeOptimalSubcycling(nlevs, best.data(), dt_max.data(), cost.data(),
+                                 cycle_max.data());
+
+        Real predicted = 0.0;
+        int nsteps = 1;
+        for (int lev = 0; lev < nlevs; ++lev) {
+            nsteps *= best[lev];
+            predicted += nsteps*cost[lev];
+        }
+
+        if (verbose > 0)
+        {
+            amrex::Print() << "Adaptive subcycling: cost per step of each level:";
+            for (int lev = 0; lev < nlevs; ++lev) {
+                amrex::Print() << " " << cost[lev];
+            }
+            amrex::Print() << "\n    n_cycle:";
+            for (int lev = 1; lev < nlevs; ++lev) {
+                amrex::Print() << " " << n_cycle[lev];
+            }
+            amrex::Print() << " ->";
+            for (int lev = 1; lev < nlevs; ++lev) {
+                amrex::Print() << " " << best[lev];
+            }
+            amrex::Print() << "\n    coarse step time: realized " << realized;
+            if (predicted_step_time > 0.0) {
+                amrex::Print() << ", predicted " << predicted_step_time;
+            }
+            amrex::Print() << ", predicted with new n_cycle " << predicted << "\n";
+        }
+
+        for (int lev = 1; lev < nlevs; ++lev) {
+            n_cycle[lev] = best[lev];
+        }
+        predicted_step_time = predicted;
+    }
+    else
+    {
+        predicted_step_time = -1.0;
+    }
+
+    for (int lev = 0; lev <= max_level; ++lev) {
+        level_time[lev] = 0.0;
+        level_time_count[lev] = 0;
+    }
+    coarse_step_time = 0.0;
+    coarse_step_count = 0;
+}
+
 Real
 Amr::computeOptimalSubcycling(int n, int* best, Real* dt_max, Real* est_work, int* cycle_max)
 {
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <memory>
 #include <limits>
+#include <map>
 
 namespace amrex {
 
@@ -164,7 +165,7 @@ AmrLevel::writePlotFile (const std::string& dir,
     }
 
     int num_derive = 0;
-    std::vector<std::string> derive_names;
+    Vector<std::string> derive_names;
     const std::list<DeriveRec>& dlist = derive_lst.dlist();
     for (auto const& d : dlist)
     {
@@ -337,10 +338,18 @@ AmrLevel::writePlotFile (const std::string& dir,
     // derived
     if (derive_names.size() > 0)
     {
-        for (auto const& dname : derive_names)
+        if (Amr::Plot_Batch_Derive())
         {
-            derive(dname, cur_time, plotMF, cnt);
-            cnt += derive_lst.get(dname)->numDerive();
+            derive(derive_names, cur_time, plotMF, cnt);
+            cnt += num_derive;
+        }
+        else
+        {
+            for (auto const& dname : derive_names)
+            {
+                derive(dname, cur_time, plotMF, cnt);
+                cnt += derive_lst.get(dname)->numDerive();
+            }
         }
     }
 
@@ -565,9 +574,77 @@ AmrLevel::checkPointPost (const std::string& /*dir*/,
 
 AmrLevel::~AmrLevel ()
 {
+    for (int i = 0; i < m_prefetch_pending.size(); ++i) {
+        if (m_prefetch_pending[i]) {
+            m_prefetch[i]->ParallelCopy_finish();
+        }
+    }
     parent = 0;
 }
 
+void
+AmrLevel::prefetchNewData (const BoxArray& ba, const DistributionMapping& dm)
+{
+    BL_PROFILE("AmrLevel::prefetchNewData()");
+
+    BL_ASSERT(m_prefetch.empty());
+
+    // FillPatch onto the same grids does not communicate.
+    if (ba == grids && dm == dmap) return;
+
+    // The intersections of the new grids with this level, owned by the
+    // processes that own the new grids.
+    BoxList bl;
+    Vector<int> pmap;
+    for (int i = 0, N = ba.size(); i < N; ++i)
+    {
+        for (auto const& is : grids.intersections(ba[i]))
+        {
+            bl.push_back(is.second);
+            pmap.push_back(dm[i]);
+        }
+    }
+    if (bl.isEmpty()) return;
+
+    const BoxArray pba(std::move(bl));
+    const DistributionMapping pdm(std::move(pmap));
+
+    m_prefetch_ba = ba;
+    m_prefetch_dm = dm;
+    m_prefetch.resize(desc_lst.size());
+    m_prefetch_pending.resize(desc_lst.size(), 0);
+
+    for (int i = 0; i < desc_lst.size(); ++i)
+    {
+        if (!state[i].hasNewData()) continue;
+
+        const MultiFab& src = state[i].newData();
+        m_prefetch[i] = std::make_unique<MultiFab>(amrex::convert(pba, src.ixType()), pdm,
+                                                   src.nComp(), 0);
+        m_prefetch[i]->ParallelCopy_nowait(src, 0, 0, src.nComp());
+        m_prefetch_pending[i] = 1;
+    }
+}
+
+MultiFab*
+AmrLevel::prefetchedNewData (int index, const Vector<MultiFab*>& fmf, const MultiFab& dst)
+{
+    if (index >= m_prefetch.size() || !m_prefetch[index]
+        || fmf.size() != 1 || fmf[0] != &state[index].newData()
+        || dst.ixType() != m_prefetch[index]->ixType()
+        || !dst.boxArray().CellEqual(m_prefetch_ba)
+        || dst.DistributionMap() != m_prefetch_dm)
+    {
+        return nullptr;
+    }
+
+    if (m_prefetch_pending[index]) {
+        m_prefetch[index]->ParallelCopy_finish();
+        m_prefetch_pending[index] = 0;
+    }
+    return m_prefetch[index].get();
+}
+
 void
 AmrLevel::allocOldData ()
 {
@@ -1006,6 +1083,10 @@ FillPatchIterator::Initialize (int  boxGrow,
     const IndexType& boxType = m_leveldata.boxArray().ixType();
     const int level = m_amrlevel.level;
 
+    // Ranges that can be filled with FillPatchSingleLevel or
+    // FillPatchTwoLevels are batched so that they share communication.
+    Vector<int> batch_scomp, batch_dcomp, batch_ncomp;
+
     for (int i = 0, DComp = 0; i < static_cast<int>(m_range.size()); i++)
     {
         const int SComp = m_range[i].first;
@@ -1013,7 +1094,9 @@ FillPatchIterator::Initialize (int  boxGrow,
 
         if (level == 0)
         {
-            FillFromLevel0(time, idx, SComp, DComp, NComp);
+            batch_scomp.push_back(SComp);
+            batch_dcomp.push_back(DComp);
+            batch_ncomp.push_back(NComp);
         }
         else
         {
@@ -1022,7 +1105,9 @@ FillPatchIterator::Initialize (int  boxGrow,
                                       m_amrlevel.parent->blockingFactor(m_amrlevel.level),
                                       boxGrow, boxType, desc.interp(SComp)))
             {
-                FillFromTwoLevels(time, idx, SComp, DComp, NComp);
+                batch_scomp.push_back(SComp);
+                batch_dcomp.push_back(DComp);
+                batch_ncomp.push_back(NComp);
             } else {
 
 #ifdef AMREX_USE_EB
@@ -1080,6 +1165,14 @@ FillPatchIterator::Initialize (int  boxGrow,
 
         DComp += NComp;
     }
+
+    if (!batch_scomp.empty())
+    {
+        const int nbatch = batch_scomp.size();
+        FillFromBatch(m_amrlevel, time, boxGrow,
+                      Vector<MultiFab*>(nbatch, &m_fabs), Vector<int>(nbatch, idx),
+                      batch_scomp, batch_dcomp, batch_ncomp);
+    }
     //
     // Call hack to touch up fillPatched data.
     //
@@ -1092,61 +1185,75 @@ FillPatchIterator::Initialize (int  boxGrow,
 }
 
 void
-FillPatchIterator::FillFromLevel0 (Real time, int idx, int scomp, int dcomp, int ncomp)
+FillPatchIterator::FillFromBatch (AmrLevel& amrlevel, Real time, int boxGrow,
+                                  Vector<MultiFab*> const& mf,
+                                  Vector<int> const& index,
+                                  Vector<int> const& scomp,
+                                  Vector<int> const& dcomp,
+                                  Vector<int> const& ncomp)
 {
-    BL_ASSERT(m_amrlevel.level == 0);
-
-    StateData& statedata = m_amrlevel.state[idx];
-
-    Vector<MultiFab*> smf;
-    Vector<Real> stime;
-    statedata.getData(smf,stime,time);
-
-    const Geometry& geom = m_amrlevel.geom;
-
-    StateDataPhysBCFunct physbcf(statedata,scomp,geom);
-
-    amrex::FillPatchSingleLevel (m_fabs, time, smf, stime, scomp, dcomp, ncomp, geom, physbcf, scomp);
-}
-
-void
-FillPatchIterator::FillFromTwoLevels (Real time, int idx, int scomp, int dcomp, int ncomp)
-{
-    int ilev_fine = m_amrlevel.level;
-    int ilev_crse = ilev_fine-1;
-
-    BL_ASSERT(ilev_crse >= 0);
+    BL_PROFILE("FillPatchIterator::FillFromBatch()");
 
-    AmrLevel& fine_level = m_amrlevel;
-    AmrLevel& crse_level = m_amrlevel.parent->getLevel(ilev_crse);
+    const int nitems = mf.size();
+    const int ilev_fine = amrlevel.level;
+    const int ilev_crse = ilev_fine-1;
+    const Geometry& geom_fine = amrlevel.geom;
 
-    const Geometry& geom_fine = fine_level.geom;
-    const Geometry& geom_crse = crse_level.geom;
+    // The physical BC functors have to outlive the items pointing to them.
+    Vector<StateDataPhysBCFunct> physbcf_fine;
+    Vector<StateDataPhysBCFunct> physbcf_crse;
+    physbcf_fine.reserve(nitems);
+    physbcf_crse.reserve(nitems);
 
-    Vector<MultiFab*> smf_crse;
-    Vector<Real> stime_crse;
-    StateData& statedata_crse = crse_level.state[idx];
-    statedata_crse.getData(smf_crse,stime_crse,time);
-    StateDataPhysBCFunct physbcf_crse(statedata_crse,scomp,geom_crse);
+    Vector<FillPatchBatchItem<MultiFab,StateDataPhysBCFunct> > items(nitems);
 
-    Vector<MultiFab*> smf_fine;
-    Vector<Real> stime_fine;
-    StateData& statedata_fine = fine_level.state[idx];
-    statedata_fine.getData(smf_fine,stime_fine,time);
-    StateDataPhysBCFunct physbcf_fine(statedata_fine,scomp,geom_fine);
+    for (int i = 0; i < nitems; ++i)
+    {
+        auto& item = items[i];
+        item.mf = mf[i];
+        item.scomp = scomp[i];
+        item.dcomp = dcomp[i];
+        item.ncomp = ncomp[i];
+
+        StateData& statedata_fine = amrlevel.state[index[i]];
+        statedata_fine.getData(item.fmf,item.ft,time);
+        if (boxGrow == 0) {
+            // In a regrid, the data may already have been copied to mf's grids.
+            if (MultiFab* pf = amrlevel.prefetchedNewData(index[i], item.fmf, *mf[i])) {
+                item.fmf[0] = pf;
+            }
+        }
+        physbcf_fine.emplace_back(statedata_fine,scomp[i],geom_fine);
+        item.fbc = &physbcf_fine.back();
+        item.fbccomp = scomp[i];
 
-    const StateDescriptor& desc = AmrLevel::desc_lst[idx];
+        if (ilev_fine > 0)
+        {
+            AmrLevel& crse_level = amrlevel.parent->getLevel(ilev_crse);
+            StateData& statedata_crse = crse_level.state[index[i]];
+            statedata_crse.getData(item.cmf,item.ct,time);
+            physbcf_crse.emplace_back(statedata_crse,scomp[i],crse_level.geom);
+            item.cbc = &physbcf_crse.back();
+            item.cbccomp = scomp[i];
+
+            const StateDescriptor& desc = AmrLevel::desc_lst[index[i]];
+            item.mapper = desc.interp(scomp[i]);
+            item.bcs = &desc.getBCs();
+            item.bcscomp = scomp[i];
+        }
+    }
 
-    amrex::FillPatchTwoLevels(m_fabs, time,
-                              smf_crse, stime_crse,
-                              smf_fine, stime_fine,
-                              scomp, dcomp, ncomp,
-                              geom_crse, geom_fine,
-                              physbcf_crse, scomp,
-                              physbcf_fine, scomp,
-                              crse_level.fineRatio(),
-                              desc.interp(scomp),
-                              desc.getBCs(),scomp);
+    if (ilev_fine == 0)
+    {
+        amrex::FillPatchSingleLevelBatch(items, IntVect(boxGrow), time, geom_fine);
+    }
+    else
+    {
+        AmrLevel& crse_level = amrlevel.parent->getLevel(ilev_crse);
+        amrex::FillPatchTwoLevelsBatch(items, IntVect(boxGrow), time,
+                                       crse_level.geom, geom_fine,
+                                       crse_level.fineRatio());
+    }
 }
 
 static
@@ -1647,66 +1754,7 @@ AmrLevel::derive (const std::string& name, Real time, int ngrow)
         const int dncomp = rec->numDerive();
         mf = std::make_unique<MultiFab>(dstBA, dmap, dncomp, ngrow, MFInfo(), *m_factory);
 
-        if (rec->derFuncFab() != nullptr)
-        {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-            for (MFIter mfi(*mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-            {
-                const Box& bx = mfi.growntilebox(ngrow);
-                FArrayBox& derfab = (*mf)[mfi];
-                FArrayBox const& datafab = srcMF[mfi];
-                rec->derFuncFab()(bx, derfab, 0, dncomp, datafab, geom, time, rec->getBC(), level);
-            }
-        }
-        else
-        {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-        for (MFIter mfi(*mf,true); mfi.isValid(); ++mfi)
-        {
-            int         grid_no = mfi.index();
-            Real*       ddat    = (*mf)[mfi].dataPtr();
-            const int*  dlo     = (*mf)[mfi].loVect();
-            const int*  dhi     = (*mf)[mfi].hiVect();
-            const Box&  gtbx    = mfi.growntilebox();
-            const int*  lo      = gtbx.loVect();
-            const int*  hi      = gtbx.hiVect();
-            int         n_der   = rec->numDerive();
-            Real*       cdat    = srcMF[mfi].dataPtr();
-            const int*  clo     = srcMF[mfi].loVect();
-            const int*  chi     = srcMF[mfi].hiVect();
-            int         n_state = rec->numState();
-            const int*  dom_lo  = state[index].getDomain().loVect();
-            const int*  dom_hi  = state[index].getDomain().hiVect();
-            const Real* dx      = geom.CellSize();
-            const int*  bcr     = rec->getBC();
-            const RealBox temp    (gtbx,geom.CellSize(),geom.ProbLo());
-            const Real* xlo     = temp.lo();
-            Real        dt      = parent->dtLevel(level);
-
-            if (rec->derFunc() != static_cast<DeriveFunc>(0)){
-               rec->derFunc()(ddat,AMREX_ARLIM(dlo),AMREX_ARLIM(dhi),&n_der,
-                              cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),&n_state,
-                              lo,hi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
-                              &level,&grid_no);
-            } else if (rec->derFunc3D() != static_cast<DeriveFunc3D>(0)){
-               const int *bc3D = rec->getBC3D();
-               rec->derFunc3D()(ddat,AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),&n_der,
-                                cdat,AMREX_ARLIM_3D(clo),AMREX_ARLIM_3D(chi),&n_state,
-                                AMREX_ARLIM_3D(lo),AMREX_ARLIM_3D(hi),
-                                AMREX_ARLIM_3D(dom_lo),AMREX_ARLIM_3D(dom_hi),
-                                AMREX_ZFILL(dx),AMREX_ZFILL(xlo),
-                                &time,&dt,
-                                bc3D,
-                                &level,&grid_no);
-            } else {
-               amrex::Error("AmrLevel::derive: no function available");
-            }
-        }
-        }
+        computeDerive(*rec, time, *mf, 0, srcMF, index);
     }
     else
     {
@@ -1757,76 +1805,212 @@ AmrLevel::derive (const std::string& name, Real time, MultiFab& mf, int dcomp)
             FillPatch(*this,srcMF,ngrow_src,time,index,scomp,ncomp,dc);
         }
 
-        if (rec->derFuncFab() != nullptr)
-        {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-            for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-            {
-                const Box& bx = mfi.growntilebox();
-                FArrayBox& derfab = mf[mfi];
-                FArrayBox const& datafab = srcMF[mfi];
-                const int dncomp = rec->numDerive();
-                rec->derFuncFab()(bx, derfab, dcomp, dncomp, datafab, geom, time, rec->getBC(), level);
+        computeDerive(*rec, time, mf, dcomp, srcMF, index);
+    }
+    else
+    {
+        //
+        // If we got here, cannot derive given name.
+        //
+        std::string msg("AmrLevel::derive(MultiFab*): unknown variable: ");
+        msg += name;
+        amrex::Error(msg.c_str());
+    }
+}
+
+void
+AmrLevel::derive (const Vector<std::string>& names, Real time, MultiFab& mf, int dcomp)
+{
+    BL_PROFILE("AmrLevel::derive(names)");
+
+    const int ngrow = mf.nGrow();
+    const int nnames = names.size();
+
+    //
+    // The derived quantities computed from the shared state data are the
+    // cell-centered ones with a derive function and cell-centered sources.
+    //
+    Vector<DeriveRec const*> shared(nnames, nullptr);
+    Vector<int> der_dcomp(nnames);
+    std::map<int,Vector<int> > needed; // state index -> components needed
+    int ngrow_src = ngrow;
+
+    for (int i = 0, dc = dcomp; i < nnames; ++i)
+    {
+        der_dcomp[i] = dc;
+
+        int index, scomp, ncomp;
+        if (isStateVariable(names[i], index, scomp)) {
+            dc += 1;
+            continue;
+        }
+        const DeriveRec* rec = derive_lst.get(names[i]);
+        if (rec == nullptr) {
+            std::string msg("AmrLevel::derive(names): unknown variable: ");
+            msg += names[i];
+            amrex::Error(msg.c_str());
+        }
+        dc += rec->numDerive();
+
+        bool ok = rec->deriveType() == mf.ixType() && mf.ixType().cellCentered() &&
+            (rec->derFuncFab() != nullptr || rec->derFunc() != nullptr ||
+             rec->derFunc3D() != nullptr);
+        for (int k = 0; k < rec->numRange() && ok; ++k) {
+            rec->getRange(k, index, scomp, ncomp);
+            ok = desc_lst[index].getType() == IndexType::TheCellType();
+        }
+        if (!ok) { continue; }
+
+        shared[i] = rec;
+        for (int k = 0; k < rec->numRange(); ++k) {
+            rec->getRange(k, index, scomp, ncomp);
+            auto& comps = needed[index];
+            comps.resize(desc_lst[index].nComp(), 0);
+            for (int n = scomp; n < scomp+ncomp; ++n) {
+                comps[n] = 1;
             }
         }
-        else
-        {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-        for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
+        Box bx0 = grids[0];
+        Box bx1 = rec->boxMap()(bx0);
+        ngrow_src = std::max(ngrow_src, ngrow + bx0.smallEnd(0) - bx1.smallEnd(0));
+    }
+
+    //
+    // Fill the union of the needed components, each contiguous run of
+    // components of a state type once, in a single batched FillPatch.
+    //
+    std::map<int,Vector<int> > position; // state index -> component in srcMF
+    Vector<int> fp_index, fp_scomp, fp_ncomp, fp_dcomp;
+    int nsrc = 0;
+    for (auto const& kv : needed)
+    {
+        auto& pos = position[kv.first];
+        pos.resize(kv.second.size(), -1);
+        for (int n = 0; n < static_cast<int>(kv.second.size()); ++n) {
+            if (kv.second[n]) {
+                if (n == 0 || !kv.second[n-1]) {
+                    fp_index.push_back(kv.first);
+                    fp_scomp.push_back(n);
+                    fp_ncomp.push_back(0);
+                    fp_dcomp.push_back(nsrc);
+                }
+                ++fp_ncomp.back();
+                pos[n] = nsrc++;
+            }
+        }
+    }
+
+    if (nsrc > 0)
+    {
+        MultiFab srcMF(grids, dmap, nsrc, ngrow_src, MFInfo(), *m_factory);
+        Vector<MultiFab*> fp_mf(fp_index.size(), &srcMF);
+        FillPatch(*this, fp_mf, ngrow_src, time, fp_index, fp_scomp, fp_ncomp, fp_dcomp);
+
+        for (int i = 0; i < nnames; ++i)
         {
-            int         idx     = mfi.index();
-            Real*       ddat    = mf[mfi].dataPtr(dcomp);
-            const int*  dlo     = mf[mfi].loVect();
-            const int*  dhi     = mf[mfi].hiVect();
-            const Box&  gtbx    = mfi.growntilebox();
-            const int*  lo      = gtbx.loVect();
-            const int*  hi      = gtbx.hiVect();
-            int         n_der   = rec->numDerive();
-            Real*       cdat    = srcMF[mfi].dataPtr();
-            const int*  clo     = srcMF[mfi].loVect();
-            const int*  chi     = srcMF[mfi].hiVect();
-            int         n_state = rec->numState();
-            const int*  dom_lo  = state[index].getDomain().loVect();
-            const int*  dom_hi  = state[index].getDomain().hiVect();
-            const Real* dx      = geom.CellSize();
-            const int*  bcr     = rec->getBC();
-            const RealBox& temp = RealBox(gtbx,geom.CellSize(),geom.ProbLo());
-            const Real* xlo     = temp.lo();
-            Real        dt      = parent->dtLevel(level);
-
-            if (rec->derFunc() != static_cast<DeriveFunc>(0)){
-               rec->derFunc()(ddat,AMREX_ARLIM(dlo),AMREX_ARLIM(dhi),&n_der,
-                              cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),&n_state,
-                              lo,hi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
-                              &level,&idx);
-            } else if (rec->derFunc3D() != static_cast<DeriveFunc3D>(0)){
-               const int *bc3D = rec->getBC3D();
-               rec->derFunc3D()(ddat,AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),&n_der,
-                                cdat,AMREX_ARLIM_3D(clo),AMREX_ARLIM_3D(chi),&n_state,
-                                AMREX_ARLIM_3D(lo),AMREX_ARLIM_3D(hi),
-                                AMREX_ARLIM_3D(dom_lo),AMREX_ARLIM_3D(dom_hi),
-                                AMREX_ZFILL(dx),AMREX_ZFILL(xlo),
-                                &time,&dt,
-                                bc3D,
-                                &level,&idx);
+            const DeriveRec* rec = shared[i];
+            if (rec == nullptr) { continue; }
+
+            // The components of rec in srcMF, in the order of its ranges
+            Vector<int> src_comps;
+            int index, scomp, ncomp;
+            for (int k = 0; k < rec->numRange(); ++k) {
+                rec->getRange(k, index, scomp, ncomp);
+                for (int n = scomp; n < scomp+ncomp; ++n) {
+                    src_comps.push_back(position[index][n]);
+                }
+            }
+            rec->getRange(0, index, scomp, ncomp);
+
+            bool contiguous = true;
+            for (int n = 1; n < static_cast<int>(src_comps.size()); ++n) {
+                contiguous = contiguous && (src_comps[n] == src_comps[0]+n);
+            }
+
+            if (contiguous) {
+                MultiFab src(srcMF, amrex::make_alias, src_comps[0], rec->numState());
+                computeDerive(*rec, time, mf, der_dcomp[i], src, index);
             } else {
-               amrex::Error("AmrLevel::derive: no function available");
+                MultiFab src(grids, dmap, rec->numState(), ngrow_src, MFInfo(), *m_factory);
+                for (int n = 0; n < rec->numState(); ++n) {
+                    MultiFab::Copy(src, srcMF, src_comps[n], n, 1, ngrow_src);
+                }
+                computeDerive(*rec, time, mf, der_dcomp[i], src, index);
             }
         }
+    }
+
+    for (int i = 0; i < nnames; ++i) {
+        if (shared[i] == nullptr) {
+            derive(names[i], time, mf, der_dcomp[i]);
+        }
+    }
+}
+
+void
+AmrLevel::computeDerive (const DeriveRec& rec, Real time, MultiFab& mf, int dcomp,
+                         MultiFab& srcMF, int index)
+{
+    if (rec.derFuncFab() != nullptr)
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.growntilebox();
+            FArrayBox& derfab = mf[mfi];
+            FArrayBox const& datafab = srcMF[mfi];
+            const int dncomp = rec.numDerive();
+            rec.derFuncFab()(bx, derfab, dcomp, dncomp, datafab, geom, time, rec.getBC(), level);
         }
     }
     else
     {
-        //
-        // If we got here, cannot derive given name.
-        //
-        std::string msg("AmrLevel::derive(MultiFab*): unknown variable: ");
-        msg += name;
-        amrex::Error(msg.c_str());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
+    {
+        int         idx     = mfi.index();
+        Real*       ddat    = mf[mfi].dataPtr(dcomp);
+        const int*  dlo     = mf[mfi].loVect();
+        const int*  dhi     = mf[mfi].hiVect();
+        const Box&  gtbx    = mfi.growntilebox();
+        const int*  lo      = gtbx.loVect();
+        const int*  hi      = gtbx.hiVect();
+        int         n_der   = rec.numDerive();
+        Real*       cdat    = srcMF[mfi].dataPtr();
+        const int*  clo     = srcMF[mfi].loVect();
+        const int*  chi     = srcMF[mfi].hiVect();
+        int         n_state = rec.numState();
+        const int*  dom_lo  = state[index].getDomain().loVect();
+        const int*  dom_hi  = state[index].getDomain().hiVect();
+        const Real* dx      = geom.CellSize();
+        const int*  bcr     = rec.getBC();
+        const RealBox& temp = RealBox(gtbx,geom.CellSize(),geom.ProbLo());
+        const Real* xlo     = temp.lo();
+        Real        dt      = parent->dtLevel(level);
+
+        if (rec.derFunc() != static_cast<DeriveFunc>(0)){
+           rec.derFunc()(ddat,AMREX_ARLIM(dlo),AMREX_ARLIM(dhi),&n_der,
+                           cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),&n_state,
+                           lo,hi,dom_lo,dom_hi,dx,xlo,&time,&dt,bcr,
+                           &level,&idx);
+        } else if (rec.derFunc3D() != static_cast<DeriveFunc3D>(0)){
+           const int *bc3D = rec.getBC3D();
+           rec.derFunc3D()(ddat,AMREX_ARLIM_3D(dlo),AMREX_ARLIM_3D(dhi),&n_der,
+                             cdat,AMREX_ARLIM_3D(clo),AMREX_ARLIM_3D(chi),&n_state,
+                             AMREX_ARLIM_3D(lo),AMREX_ARLIM_3D(hi),
+                             AMREX_ARLIM_3D(dom_lo),AMREX_ARLIM_3D(dom_hi),
+                             AMREX_ZFILL(dx),AMREX_ZFILL(xlo),
+                             &time,&dt,
+                             bc3D,
+                             &level,&idx);
+        } else {
+           amrex::Error("AmrLevel::derive: no function available");
+        }
+    }
     }
 }
 
@@ -2130,6 +2314,73 @@ AmrLevel::FillPatchAdd (AmrLevel& amrlevel,
     MultiFab::Add(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+void
+AmrLevel::FillPatch (AmrLevel&                amrlevel,
+                     Vector<MultiFab*> const& leveldata,
+                     int                      boxGrow,
+                     Real                     time,
+                     Vector<int> const&       index,
+                     Vector<int> const&       scomp,
+                     Vector<int> const&       ncomp,
+                     Vector<int> const&       dcomp)
+{
+    BL_PROFILE("AmrLevel::FillPatch(batch)");
+
+    const int nstates = leveldata.size();
+    BL_ASSERT(index.size() == nstates && scomp.size() == nstates &&
+              ncomp.size() == nstates && dcomp.size() == nstates);
+
+    Vector<MultiFab*> batch_mf;
+    Vector<int> batch_index, batch_scomp, batch_dcomp, batch_ncomp;
+    bool nested = true;
+
+    for (int i = 0; i < nstates && nested; ++i)
+    {
+        BL_ASSERT(dcomp[i]+ncomp[i]-1 <= leveldata[i]->nComp());
+        BL_ASSERT(boxGrow <= leveldata[i]->nGrow());
+
+        const StateDescriptor& desc = AmrLevel::desc_lst[index[i]];
+        for (auto const& r : desc.sameInterps(scomp[i],ncomp[i]))
+        {
+            if (amrlevel.level > 1 &&
+                !amrex::ProperlyNested(amrlevel.crse_ratio,
+                                       amrlevel.parent->blockingFactor(amrlevel.level),
+                                       boxGrow, leveldata[i]->ixType(), desc.interp(r.first)))
+            {
+                nested = false;
+                break;
+            }
+            batch_mf.push_back(leveldata[i]);
+            batch_index.push_back(index[i]);
+            batch_scomp.push_back(r.first);
+            batch_dcomp.push_back(dcomp[i]+r.first-scomp[i]);
+            batch_ncomp.push_back(r.second);
+        }
+    }
+
+    if (!nested)
+    {
+        // FillPatchIterator knows how to deal with improperly nested grids.
+        for (int i = 0; i < nstates; ++i) {
+            FillPatch(amrlevel, *leveldata[i], boxGrow, time, index[i], scomp[i], ncomp[i], dcomp[i]);
+        }
+        return;
+    }
+
+    for (int i = 0; i < nstates; ++i) {
+        leveldata[i]->setDomainBndry(std::numeric_limits<Real>::quiet_NaN(),
+                                     dcomp[i], ncomp[i], amrlevel.geom);
+    }
+
+    FillPatchIterator::FillFromBatch(amrlevel, time, boxGrow, batch_mf, batch_index,
+                                     batch_scomp, batch_dcomp, batch_ncomp);
+
+    for (int i = 0; i < nstates; ++i) {
+        amrlevel.set_preferred_boundary_values(*leveldata[i], index[i], scomp[i],
+                                               dcomp[i], ncomp[i], time);
+    }
+}
+
 void
 AmrLevel::LevelDirectoryNames (const std::string &dir,
                                std::string &LevelDir,
@@ -479,11 +479,11 @@ FluxRegister::Reflux (MultiFab&       mf,
                       int             nc,
                       const Geometry& geom)
 {
-    for (OrientationIter fi; fi; ++fi)
-    {
-        const Orientation& face = fi();
-        Reflux(mf, volume, face, scale, scomp, dcomp, nc, geom);
+    Vector<Orientation> faces;
+    for (OrientationIter fi; fi; ++fi) {
+        faces.push_back(fi());
     }
+    Reflux(mf, volume, faces, scale, scomp, dcomp, nc, geom);
 }
 
 void
@@ -496,12 +496,8 @@ FluxRegister::Reflux (MultiFab&       mf,
                       int             nc,
                       const Geometry& geom)
 {
-    for (int s = 0; s < 2; ++s)
-    {
-        Orientation::Side side = (s==0) ? Orientation::low : Orientation::high;
-        Orientation face(dir, side);
-        Reflux(mf, volume, face, scale, scomp, dcomp, nc, geom);
-    }
+    Reflux(mf, volume, {Orientation(dir,Orientation::low), Orientation(dir,Orientation::high)},
+           scale, scomp, dcomp, nc, geom);
 }
 
 void
@@ -545,29 +541,45 @@ void
 FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Orientation face,
                       Real scale, int scomp, int dcomp, int nc, const Geometry& geom)
 {
-    BL_PROFILE("FluxRegister::Reflux()");
+    Reflux(mf, volume, Vector<Orientation>{face}, scale, scomp, dcomp, nc, geom);
+}
 
-    int idir = face.coordDir();
+void
+FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Vector<Orientation> const& faces,
+                      Real scale, int scomp, int dcomp, int nc, const Geometry& geom)
+{
+    BL_PROFILE("FluxRegister::Reflux()");
 
-    MultiFab flux(amrex::convert(mf.boxArray(), IntVect::TheDimensionVector(idir)),
-                  mf.DistributionMap(), nc, 0, MFInfo(), mf.Factory());
-    flux.setVal(0.0);
+    // Start the communication of all faces before adding any of them.
+    Vector<MultiFab> flux(faces.size());
+    for (int i = 0; i < faces.size(); ++i)
+    {
+        int idir = faces[i].coordDir();
+        flux[i].define(amrex::convert(mf.boxArray(), IntVect::TheDimensionVector(idir)),
+                       mf.DistributionMap(), nc, 0, MFInfo(), mf.Factory());
+        flux[i].setVal(0.0);
+        bndry[faces[i]].copyTo_nowait(flux[i], 0, scomp, 0, nc, geom.periodicity());
+    }
 
-    bndry[face].copyTo(flux, 0, scomp, 0, nc, geom.periodicity());
+    for (int i = 0; i < faces.size(); ++i)
+    {
+        const Orientation face = faces[i];
+        flux[i].ParallelCopy_finish();
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const Box& bx = mfi.tilebox();
-        Array4<Real> const& sfab = mf.array(mfi);
-        Array4<Real const> const& ffab = flux.const_array(mfi);
-        Array4<Real const> const& vfab = volume.const_array(mfi);
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (bx, tbx,
+        for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
-            fluxreg_reflux(tbx, sfab, dcomp, ffab, vfab, nc, scale, face);
-        });
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& sfab = mf.array(mfi);
+            Array4<Real const> const& ffab = flux[i].const_array(mfi);
+            Array4<Real const> const& vfab = volume.const_array(mfi);
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA (bx, tbx,
+            {
+                fluxreg_reflux(tbx, sfab, dcomp, ffab, vfab, nc, scale, face);
+            });
+        }
     }
 }
 
@@ -6,12 +6,6 @@
 #include <AMReX_Interp_C.H>
 #include <AMReX_MFInterp_C.H>
 
-#ifndef BL_NO_FORT
-#include <AMReX_INTERP_F.H>
-#endif
-
-#include <climits>
-
 namespace amrex {
 
 /*
@@ -22,7 +16,7 @@ namespace amrex {
  *
  * CellQuadratic only works in 2D on cpu.
  *
- * CellConservativeQuartic only works with ref ratio of 2 on cpu
+ * CellConservativeQuartic only works with ref ratio of 2 on cpu and gpu.
  *
  * FaceDivFree works in 2D and 3D on cpu and gpu.
  * The algorithm is restricted to ref ratio of 2.
@@ -40,10 +34,8 @@ CellConservativeLinear    cell_cons_interp(0);
 CellConservativeProtected protected_interp;
 CellBilinear              cell_bilinear_interp;
 
-#ifndef BL_NO_FORT
 CellQuadratic             quadratic_interp;
 CellConservativeQuartic   quartic_interp;
-#endif
 
 NodeBilinear::~NodeBilinear () {}
 
@@ -302,6 +294,173 @@ CellBilinear::interp (const FArrayBox&  crsefab,
 }
 
 
+namespace {
+
+/*
+ * Host version of mf_cell_cons_lin_interp_fused.  It works on one row of
+ * coarse cells at a time and keeps the slopes of the row in a small buffer,
+ * so that the loops over i vectorize.  The results are the same.
+ */
+void cell_cons_lin_interp_rows (Box const& fine_region, Array4<Real> const& fine, int fcomp,
+                                Array4<Real const> const& crse, int ccomp, int ncomp,
+                                Box const& cdomain, IntVect const& ratio,
+                                BCRec const* bcr, bool lin_limit)
+{
+    const Box& cbx = amrex::coarsen(fine_region, ratio);
+    const auto clo = amrex::lbound(cbx);
+    const auto chi = amrex::ubound(cbx);
+    const auto flo = amrex::lbound(fine_region);
+    const auto fhi = amrex::ubound(fine_region);
+    const int nx = cbx.length(0);
+    const Dim3 r{ratio[0], AMREX_D_PICK(1,ratio[1],ratio[1]), AMREX_D_PICK(1,1,ratio[2])};
+    const GpuArray<Long,3> cstride{1, crse.jstride, crse.kstride};
+    constexpr int jd = (AMREX_SPACEDIM >= 2) ? 1 : 0;
+    constexpr int kd = (AMREX_SPACEDIM == 3) ? 1 : 0;
+
+    // slope(ii,n,d) of coarse cell clo.x+ii, and the linear limiter factors
+    Vector<Real> slope_buf(nx*ncomp*AMREX_SPACEDIM);
+    Vector<Real> factor_buf(nx*AMREX_SPACEDIM);
+    auto slope = [&] (int n, int d) { return slope_buf.data() + (n*AMREX_SPACEDIM+d)*nx; };
+
+    for (int kc = clo.z; kc <= chi.z; ++kc) {
+    for (int jc = clo.y; jc <= chi.y; ++jc) {
+        for (int n = 0; n < ncomp; ++n) {
+            const int nu = ccomp + n;
+            Real const* AMREX_RESTRICT u = crse.ptr(clo.x,jc,kc,nu);
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                Real* AMREX_RESTRICT s = slope(n,d);
+                const Long st = cstride[d];
+                AMREX_PRAGMA_SIMD
+                for (int ii = 0; ii < nx; ++ii) {
+                    s[ii] = Real(0.5) * (u[ii+st] - u[ii-st]);
+                }
+            }
+            // One-sided slopes at physical boundaries, which may be inside the row
+            for (int ic : {cdomain.smallEnd(0), cdomain.bigEnd(0)}) {
+                if (ic >= clo.x && ic <= chi.x) {
+                    slope(n,0)[ic-clo.x] = mf_compute_slopes_x(ic,jc,kc, crse, nu, cdomain, bcr[n]);
+                }
+            }
+#if (AMREX_SPACEDIM >= 2)
+            if (jc == cdomain.smallEnd(1) || jc == cdomain.bigEnd(1)) {
+                for (int ic = clo.x; ic <= chi.x; ++ic) {
+                    slope(n,1)[ic-clo.x] = mf_compute_slopes_y(ic,jc,kc, crse, nu, cdomain, bcr[n]);
+                }
+            }
+#endif
+#if (AMREX_SPACEDIM == 3)
+            if (kc == cdomain.smallEnd(2) || kc == cdomain.bigEnd(2)) {
+                for (int ic = clo.x; ic <= chi.x; ++ic) {
+                    slope(n,2)[ic-clo.x] = mf_compute_slopes_z(ic,jc,kc, crse, nu, cdomain, bcr[n]);
+                }
+            }
+#endif
+
+            if (lin_limit) {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    Real const* AMREX_RESTRICT s = slope(n,d);
+                    Real* AMREX_RESTRICT sf = factor_buf.data() + d*nx;
+                    const Long st = cstride[d];
+                    AMREX_PRAGMA_SIMD
+                    for (int ii = 0; ii < nx; ++ii) {
+                        const Real dc = s[ii];
+                        const Real lim = mf_cell_cons_lin_interp_limit(dc,
+                                                                       Real(2.0)*(u[ii+st]-u[ii]),
+                                                                       Real(2.0)*(u[ii]-u[ii-st]));
+                        const Real f = lim / ((dc != Real(0.0)) ? dc : Real(1.0));
+                        const Real sfold = (n == 0) ? Real(1.0) : sf[ii];
+                        sf[ii] = (dc != Real(0.0)) ? amrex::min(sfold, f) : sfold;
+                    }
+                }
+            } else {
+                AMREX_D_TERM(Real* AMREX_RESTRICT sx = slope(n,0);,
+                             Real* AMREX_RESTRICT sy = slope(n,1);,
+                             Real* AMREX_RESTRICT sz = slope(n,2););
+                AMREX_PRAGMA_SIMD
+                for (int ii = 0; ii < nx; ++ii) {
+                    const Real uc = u[ii];
+                    Real lim[AMREX_SPACEDIM];
+                    AMREX_D_TERM(lim[0] = mf_cell_cons_lin_interp_limit(sx[ii],
+                                     Real(2.0)*(u[ii+1]-uc), Real(2.0)*(uc-u[ii-1]));,
+                                 lim[1] = mf_cell_cons_lin_interp_limit(sy[ii],
+                                     Real(2.0)*(u[ii+cstride[1]]-uc), Real(2.0)*(uc-u[ii-cstride[1]]));,
+                                 lim[2] = mf_cell_cons_lin_interp_limit(sz[ii],
+                                     Real(2.0)*(u[ii+cstride[2]]-uc), Real(2.0)*(uc-u[ii-cstride[2]])););
+                    const Real dumax = AMREX_D_TERM(
+                          amrex::Math::abs(lim[0]) * Real(ratio[0]-1)/Real(2*ratio[0]),
+                        + amrex::Math::abs(lim[1]) * Real(ratio[1]-1)/Real(2*ratio[1]),
+                        + amrex::Math::abs(lim[2]) * Real(ratio[2]-1)/Real(2*ratio[2]));
+                    Real umax = uc;
+                    Real umin = uc;
+                    for (int koff = -kd; koff <= kd; ++koff) {
+                    for (int joff = -jd; joff <= jd; ++joff) {
+                    for (int ioff = -1; ioff <= 1; ++ioff) {
+                        const Real un = u[ii + ioff + joff*cstride[1] + koff*cstride[2]];
+                        umin = amrex::min(umin, un);
+                        umax = amrex::max(umax, un);
+                    }}}
+                    // Without slopes, dumax is zero and alpha stays one.
+                    const Real dudiv = (dumax != Real(0.0)) ? dumax : Real(1.0);
+                    Real alpha = Real(1.0);
+                    alpha = (dumax * alpha > (umax - uc)) ? (umax - uc) / dudiv : alpha;
+                    alpha = (dumax * alpha > (uc - umin)) ? (uc - umin) / dudiv : alpha;
+                    AMREX_D_TERM(sx[ii] = lim[0] * alpha;,
+                                 sy[ii] = lim[1] * alpha;,
+                                 sz[ii] = lim[2] * alpha;);
+                }
+            }
+        }
+
+        if (lin_limit) {
+            for (int n = 0; n < ncomp; ++n) {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    Real* AMREX_RESTRICT s = slope(n,d);
+                    Real const* AMREX_RESTRICT sf = factor_buf.data() + d*nx;
+                    AMREX_PRAGMA_SIMD
+                    for (int ii = 0; ii < nx; ++ii) {
+                        s[ii] *= sf[ii];
+                    }
+                }
+            }
+        }
+
+        // The fine cells of the row, one offset within the coarse cells at a time
+        const int klo = amrex::max(kc*r.z, flo.z);
+        const int khi = amrex::min(kc*r.z+r.z-1, fhi.z);
+        const int jlo = amrex::max(jc*r.y, flo.y);
+        const int jhi = amrex::min(jc*r.y+r.y-1, fhi.y);
+        for (int k = klo; k <= khi; ++k) {
+        for (int j = jlo; j <= jhi; ++j) {
+            AMREX_D_TERM(,
+                         const Real yoff = (j - jc*r.y + Real(0.5)) / Real(r.y) - Real(0.5);,
+                         const Real zoff = (k - kc*r.z + Real(0.5)) / Real(r.z) - Real(0.5););
+            for (int ioff = 0; ioff < ratio[0]; ++ioff) {
+                const Real xoff = (ioff + Real(0.5)) / Real(ratio[0]) - Real(0.5);
+                // coarse cells whose fine cell ic*ratio+ioff is in the fine region
+                int iclo = amrex::coarsen(flo.x, ratio[0]);
+                if (iclo*ratio[0]+ioff < flo.x) { ++iclo; }
+                int ichi = amrex::coarsen(fhi.x, ratio[0]);
+                if (ichi*ratio[0]+ioff > fhi.x) { --ichi; }
+                for (int n = 0; n < ncomp; ++n) {
+                    Real const* AMREX_RESTRICT u = crse.ptr(clo.x,jc,kc,ccomp+n) - clo.x;
+                    Real* AMREX_RESTRICT f = fine.ptr(flo.x,j,k,fcomp+n) - flo.x + ioff;
+                    AMREX_D_TERM(Real const* AMREX_RESTRICT sx = slope(n,0) - clo.x;,
+                                 Real const* AMREX_RESTRICT sy = slope(n,1) - clo.x;,
+                                 Real const* AMREX_RESTRICT sz = slope(n,2) - clo.x;);
+                    AMREX_PRAGMA_SIMD
+                    for (int ic = iclo; ic <= ichi; ++ic) {
+                        f[ic*ratio[0]] = u[ic] + AMREX_D_TERM(  xoff * sx[ic],
+                                                              + yoff * sy[ic],
+                                                              + zoff * sz[ic]);
+                    }
+                }
+            }
+        }}
+    }}
+}
+
+}
+
 CellConservativeLinear::CellConservativeLinear (bool do_linear_limiting_)
 {
     do_linear_limiting = do_linear_limiting_;
@@ -362,14 +521,13 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     AsyncArray<BCRec> async_bcr(bcr.data(), (run_on_gpu) ? ncomp : 0);
     BCRec const* bcrp = (run_on_gpu) ? async_bcr.data() : bcr.data();
 
-    FArrayBox ccfab(cslope_bx, ncomp*AMREX_SPACEDIM);
-    Elixir cceli;
-    if (run_on_gpu) cceli = ccfab.elixir();
-    Array4<Real> const& tmp = ccfab.array();
-    Array4<Real const> const& ctmp = ccfab.const_array();
-
 #if (AMREX_SPACEDIM == 1)
     if (crse_geom.IsSPHERICAL()) {
+        FArrayBox ccfab(cslope_bx, ncomp*AMREX_SPACEDIM);
+        Elixir cceli;
+        if (run_on_gpu) cceli = ccfab.elixir();
+        Array4<Real> const& tmp = ccfab.array();
+        Array4<Real const> const& ctmp = ccfab.const_array();
         Real drf = fine_geom.CellSize(0);
         Real rlo = fine_geom.Offset(0);
         if (do_linear_limiting) {
@@ -396,6 +554,11 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     } else
 #elif (AMREX_SPACEDIM == 2)
     if (crse_geom.IsRZ()) {
+        FArrayBox ccfab(cslope_bx, ncomp*AMREX_SPACEDIM);
+        Elixir cceli;
+        if (run_on_gpu) cceli = ccfab.elixir();
+        Array4<Real> const& tmp = ccfab.array();
+        Array4<Real const> const& ctmp = ccfab.const_array();
         Real drf = fine_geom.CellSize(0);
         Real rlo = fine_geom.Offset(0);
         if (do_linear_limiting) {
@@ -422,29 +585,23 @@ CellConservativeLinear::interp (const FArrayBox& crse,
     } else
 #endif
     {
-        if (do_linear_limiting) {
-            AMREX_HOST_DEVICE_PARALLEL_FOR_3D_FLAG(runon, cslope_bx, i, j, k,
+        // Slopes, limiting and the fine cells of all components in one
+        // pass over the coarse cells, without a slope temporary.
+        const bool lin_limit = do_linear_limiting;
+        if (run_on_gpu) {
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D_FLAG(runon, cslope_bx, ic, jc, kc,
             {
-                mf_cell_cons_lin_interp_llslope(i,j,k, tmp, crsearr, crse_comp, ncomp,
-                                                cdomain, bcrp);
+                mf_cell_cons_lin_interp_fused(ic,jc,kc, fine_region, finearr, fine_comp,
+                                              crsearr, crse_comp, ncomp, cdomain, ratio,
+                                              bcrp, lin_limit);
             });
         } else {
-            AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, cslope_bx, ncomp, i, j, k, n,
-            {
-                mf_cell_cons_lin_interp_mcslope(i,j,k,n, tmp, crsearr, crse_comp, ncomp,
-                                                cdomain, ratio, bcrp);
-            });
+            cell_cons_lin_interp_rows(fine_region, finearr, fine_comp, crsearr, crse_comp,
+                                      ncomp, cdomain, ratio, bcrp, lin_limit);
         }
-
-        AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, fine_region, ncomp, i, j, k, n,
-        {
-            mf_cell_cons_lin_interp(i,j,k,n, finearr, fine_comp, ctmp,
-                                    crsearr, crse_comp, ncomp, ratio);
-        });
     }
 }
 
-#ifndef BL_NO_FORT
 CellQuadratic::CellQuadratic (bool limit)
 {
     do_limited_slope = limit;
@@ -485,96 +642,56 @@ CellQuadratic::interp (const FArrayBox& crse,
                        int              actual_state,
                        RunOn            /*runon*/)
 {
-#if (AMREX_SPACEDIM == 1)
+#if (AMREX_SPACEDIM != 2)
     amrex::ignore_unused(crse,crse_comp,fine,fine_comp,ncomp,fine_region,
                          ratio,crse_geom,fine_geom,bcr,actual_comp,actual_state);
-    amrex::Abort("1D CellQuadratic::interp not supported");
+    amrex::Abort("CellQuadratic::interp only supported in 2D");
 #else
     BL_PROFILE("CellQuadratic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
+    amrex::ignore_unused(actual_comp,actual_state);
     //
     // Make box which is intersection of fine_region and domain of fine.
     //
     Box target_fine_region = fine_region & fine.box();
 
     Box crse_bx(amrex::coarsen(target_fine_region,ratio));
-    Box fslope_bx(amrex::refine(crse_bx,ratio));
-    Box cslope_bx(crse_bx);
-    cslope_bx.grow(1);
-    BL_ASSERT(crse.box().contains(cslope_bx));
-    //
-    // Alloc temp space for coarse grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms
-    //
-    long t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int c_len = int(t_long);
-
-    Vector<Real> cslope(5*c_len);
-
-    int loslp = cslope_bx.index(crse_bx.smallEnd());
-    int hislp = cslope_bx.index(crse_bx.bigEnd());
-
-    t_long = cslope_bx.numPts();
-    BL_ASSERT(t_long < INT_MAX);
-    int cslope_vol = int(t_long);
-    int clo        = 1 - loslp;
-    int chi        = clo + cslope_vol - 1;
-    c_len          = hislp - loslp + 1;
+    BL_ASSERT(crse.box().contains(amrex::grow(crse_bx,1)));
     //
-    // Alloc temp space for one strip of fine grid slopes: here we use 5
-    // instead of AMREX_SPACEDIM because of the x^2, y^2 and xy terms.
+    // Offsets of the fine cell centers from the coarse cell centers, in
+    // the edge-centered volume coordinates of each direction.
     //
-    int dir;
-    int f_len = fslope_bx.longside(dir);
+    Vector<Real> off[AMREX_SPACEDIM];
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
+    {
+        Vector<Real> fvc, cvc;
+        fine_geom.GetEdgeVolCoord(fvc,target_fine_region,dir);
+        crse_geom.GetEdgeVolCoord(cvc,crse_bx,dir);
+        const int flo = target_fine_region.smallEnd(dir);
+        const int clo = crse_bx.smallEnd(dir);
+        off[dir].resize(target_fine_region.length(dir));
+        for (int i = flo; i <= target_fine_region.bigEnd(dir); ++i) {
+            const int ic = amrex::coarsen(i,ratio[dir]);
+            const Real fcen = Real(0.5)*(fvc[i-flo]+fvc[i-flo+1]);
+            const Real ccen = Real(0.5)*(cvc[ic-clo]+cvc[ic-clo+1]);
+            off[dir][i-flo] = (fcen-ccen)/(cvc[ic-clo+1]-cvc[ic-clo]);
+        }
+    }
 
-    Vector<Real> strip((5+2)*f_len);
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
+    Real const* xoff = off[0].data();
+    Real const* yoff = off[1].data();
+    BCRec const* bcrp = bcr.data();
 
-    Real* fstrip = strip.dataPtr();
-    Real* foff   = fstrip + f_len;
-    Real* fslope = foff + f_len;
-    //
-    // Get coarse and fine edge-centered volume coordinates.
-    //
-    Vector<Real> fvc[AMREX_SPACEDIM];
-    Vector<Real> cvc[AMREX_SPACEDIM];
-    for (dir = 0; dir < AMREX_SPACEDIM; dir++)
+    amrex::LoopOnCpu(crse_bx, [&] (int ic, int jc, int) noexcept
     {
-        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
-    }
-    //
-    // Alloc tmp space for slope calc and to allow for vectorization.
-    //
-    Real* fdat        = fine.dataPtr(fine_comp);
-    const Real* cdat  = crse.dataPtr(crse_comp);
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* fslo   = fslope_bx.loVect();
-    const int* fshi   = fslope_bx.hiVect();
-    int slope_flag    = (do_limited_slope ? 1 : 0);
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-
-    amrex_cqinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                   AMREX_ARLIM(fblo), AMREX_ARLIM(fbhi),
-                   &ncomp,AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                   cdat,&clo,&chi,
-                   AMREX_ARLIM(cblo), AMREX_ARLIM(cbhi),
-                   fslo,fshi,
-                   cslope.dataPtr(),&c_len,fslope,fstrip,&f_len,foff,
-                   bc.dataPtr(), &slope_flag,
-                   AMREX_D_DECL(fvc[0].dataPtr(),fvc[1].dataPtr(),fvc[2].dataPtr()),
-                   AMREX_D_DECL(cvc[0].dataPtr(),cvc[1].dataPtr(),cvc[2].dataPtr()),
-                   &actual_comp,&actual_state);
-
-#endif /*(AMREX_SPACEDIM > 1)*/
+        cellquadratic_interp(ic, jc, target_fine_region, crse_bx, finearr, fine_comp,
+                             crsearr, crse_comp, ncomp, xoff, yoff, ratio, bcrp);
+    });
+
+#endif /*(AMREX_SPACEDIM == 2)*/
 }
-#endif
 
 
 PCInterp::~PCInterp () {}
@@ -706,7 +823,6 @@ CellConservativeProtected::protect (const FArrayBox& /*crse*/,
 
 }
 
-#ifndef BL_NO_FORT
 CellConservativeQuartic::~CellConservativeQuartic () {}
 
 Box
@@ -738,75 +854,82 @@ CellConservativeQuartic::interp (const FArrayBox&  crse,
                                  const Geometry&   /* crse_geom */,
                                  const Geometry&   /* fine_geom */,
                                  Vector<BCRec> const&   bcr,
-                                 int               actual_comp,
-                                 int               actual_state,
-                                 RunOn             /*runon*/)
+                                 int               /*actual_comp*/,
+                                 int               /*actual_state*/,
+                                 RunOn             runon)
 {
     BL_PROFILE("CellConservativeQuartic::interp()");
     BL_ASSERT(bcr.size() >= ncomp);
-    BL_ASSERT(ratio[0]==2);
-#if (AMREX_SPACEDIM >= 2)
-    BL_ASSERT(ratio[0] == ratio[1]);
-#endif
-#if (AMREX_SPACEDIM == 3)
-    BL_ASSERT(ratio[1] == ratio[2]);
-#endif
+    amrex::ignore_unused(bcr);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ratio == 2,
+                                     "CellConservativeQuartic: unsupported refinement ratio");
+
+    bool run_on_gpu = (runon == RunOn::Gpu && Gpu::inLaunchRegion());
 
     //
     // Make box which is intersection of fine_region and domain of fine.
     //
     Box target_fine_region = fine_region & fine.box();
     //
-    // crse_bx is coarsening of target_fine_region, grown by 2.
+    // crse_bx2 is coarsening of target_fine_region.  The stencils reach two
+    // coarse cells further.
     //
-    Box crse_bx = CoarseBox(target_fine_region,ratio);
-
-    Box crse_bx2(crse_bx);
-    crse_bx2.grow(-2);
-    Box fine_bx2 = amrex::refine(crse_bx2,ratio);
-
-    Real* fdat       = fine.dataPtr(fine_comp);
-    const Real* cdat = crse.dataPtr(crse_comp);
-
-    const int* flo    = fine.loVect();
-    const int* fhi    = fine.hiVect();
-    const int* clo    = crse.loVect();
-    const int* chi    = crse.hiVect();
-    const int* fblo   = target_fine_region.loVect();
-    const int* fbhi   = target_fine_region.hiVect();
-    const int* cblo   = crse_bx.loVect();
-    const int* cbhi   = crse_bx.hiVect();
-    const int* cb2lo  = crse_bx2.loVect();
-    const int* cb2hi  = crse_bx2.hiVect();
-    const int* fb2lo  = fine_bx2.loVect();
-    const int* fb2hi  = fine_bx2.hiVect();
+    Box crse_bx2 = amrex::coarsen(target_fine_region,ratio);
+    BL_ASSERT(crse.box().contains(amrex::grow(crse_bx2,2)));
 
-    Vector<int> bc     = GetBCArray(bcr);
-    const int* ratioV = ratio.getVect();
-
-    int ltmp = fb2hi[0]-fb2lo[0]+1;
-    Vector<Real> ftmp(ltmp);
-
-#if (AMREX_SPACEDIM >= 2)
-    ltmp = (cbhi[0]-cblo[0]+1)*ratio[1];
-    Vector<Real> ctmp(ltmp);
-#endif
+    Array4<Real const> const& crsearr = crse.const_array();
+    Array4<Real> const& finearr = fine.array();
 
+    //
+    // The coarse cells are split one direction at a time, from the last
+    // to x, and all components are done together.  The temporaries are
+    // fine in the directions already split.
+    //
+#if (AMREX_SPACEDIM == 1)
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, crse_bx2, ncomp, i, j, k, n,
+    {
+        quartinterp_split<0>(i,j,k,n, target_fine_region, finearr, fine_comp, crsearr, crse_comp);
+    });
+#else
+    Box ybx = amrex::grow(crse_bx2,0,2);
 #if (AMREX_SPACEDIM == 3)
-    ltmp = (cbhi[0]-cblo[0]+1)*(cbhi[1]-cblo[1]+1)*ratio[2];
-    Vector<Real> ctmp2(ltmp);
+    Box zbx = amrex::grow(ybx,1,2);
+    FArrayBox zfab(Box(zbx).setRange(2,target_fine_region.smallEnd(2),
+                                     target_fine_region.length(2)), ncomp);
+    Elixir zeli;
+    if (run_on_gpu) zeli = zfab.elixir();
+    Array4<Real> const& zarr = zfab.array();
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, zbx, ncomp, i, j, k, n,
+    {
+        quartinterp_split<2>(i,j,k,n, target_fine_region, zarr, 0, crsearr, crse_comp);
+    });
+    ybx.setRange(2,target_fine_region.smallEnd(2),target_fine_region.length(2));
+    Array4<Real const> const& yin = zfab.const_array();
+    const int yin_comp = 0;
+#else
+    Array4<Real const> const& yin = crsearr;
+    const int yin_comp = crse_comp;
 #endif
+    FArrayBox yfab(Box(ybx).setRange(1,target_fine_region.smallEnd(1),
+                                     target_fine_region.length(1)), ncomp);
+    Elixir yeli;
+    if (run_on_gpu) yeli = yfab.elixir();
+    Array4<Real> const& yarr = yfab.array();
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, ybx, ncomp, i, j, k, n,
+    {
+        quartinterp_split<1>(i,j,k,n, target_fine_region, yarr, 0, yin, yin_comp);
+    });
 
-    amrex_quartinterp (fdat,AMREX_ARLIM(flo),AMREX_ARLIM(fhi),
-                       fblo, fbhi, fb2lo, fb2hi,
-                       cdat,AMREX_ARLIM(clo),AMREX_ARLIM(chi),
-                       cblo, cbhi, cb2lo, cb2hi,
-                       &ncomp,
-                       AMREX_D_DECL(&ratioV[0],&ratioV[1],&ratioV[2]),
-                       AMREX_D_DECL(ftmp.dataPtr(), ctmp.dataPtr(), ctmp2.dataPtr()),
-                       bc.dataPtr(),&actual_comp,&actual_state);
-}
+    Box xbx = target_fine_region;
+    xbx.setRange(0,crse_bx2.smallEnd(0),crse_bx2.length(0));
+    Array4<Real const> const& xin = yfab.const_array();
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, xbx, ncomp, i, j, k, n,
+    {
+        quartinterp_split<0>(i,j,k,n, target_fine_region, finearr, fine_comp, xin, 0);
+    });
 #endif
+    amrex::ignore_unused(run_on_gpu);
+}
 
 FaceDivFree::~FaceDivFree () {}
 
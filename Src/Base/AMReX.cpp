@@ -41,6 +41,7 @@
 #include <AMReX_iMultiFab.H>
 #include <AMReX_VisMF.H>
 #include <AMReX_AsyncOut.H>
+#include <AMReX_EventTrace.H>
 #endif
 
 #ifdef BL_LAZY
@@ -495,6 +496,9 @@ amrex::Initialize (int& argc, char**& argv, bool build_parm_parse,
     //
     amrex::InitRandom(ParallelDescriptor::MyProc()+1, ParallelDescriptor::NProcs());
 
+    // Before the others so that it is finalized after them.
+    EventTrace::Initialize();
+
     // For thread safety, we should do these initializations here.
     BaseFab_Initialize();
     BoxArray::Initialize();
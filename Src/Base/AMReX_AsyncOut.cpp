@@ -4,8 +4,13 @@
 #include <AMReX_Vector.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
+#include <AMReX_BLProfiler.H>
 #include <AMReX.H>
 
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
 namespace amrex {
 namespace AsyncOut {
 
@@ -23,7 +28,15 @@ MPI_Comm s_comm = MPI_COMM_NULL;
 
 std::unique_ptr<BackgroundThread> s_thread;
 
-WriteInfo s_info;
+WriteInfo s_info{0,0,1};
+
+std::int64_t s_max_bytes = 0;
+std::int64_t s_bytes_in_flight = 0;
+std::mutex s_bytes_mutex;
+std::condition_variable s_bytes_cond;
+
+// Files prepared so far.  Jobs submitted earlier may still be writing them.
+std::set<std::string> s_prepared_files;
 
 }
 
@@ -34,23 +47,18 @@ void Initialize ()
     ParmParse pp("amrex");
     pp.query("async_out", s_asyncout);
     pp.query("async_out_nfiles", s_noutfiles);
+    pp.query("async_out_max_bytes", s_max_bytes);
 
     int nprocs = ParallelDescriptor::NProcs();
     s_noutfiles = std::min(s_noutfiles, nprocs);
 
+    int myproc = ParallelDescriptor::MyProc();
+    s_info = GetWriteInfo(myproc);
+
 #ifdef AMREX_USE_MPI
+    // Only used by PrepareFile on the main thread, and by Wait and Notify.
     if (s_asyncout && s_noutfiles < nprocs)
     {
-        int provided = -1;
-        MPI_Query_thread(&provided);
-        if (provided < MPI_THREAD_MULTIPLE) {
-            amrex::Abort("AsyncOut with " + std::to_string(s_noutfiles) + " and "
-                         + std::to_string(nprocs) + " processes requires "
-                         + "MPI_THREAD_MULTIPLE at runtime, but got "
-                         + ParallelDescriptor::mpi_level_to_string(provided));
-        }
-        int myproc = ParallelDescriptor::MyProc();
-        s_info = GetWriteInfo(myproc);
         MPI_Comm_split(ParallelDescriptor::Communicator(), s_info.ifile, myproc, &s_comm);
     }
 #endif
@@ -114,6 +122,67 @@ void Finish ()
     s_thread->Finish();
 }
 
+std::int64_t PrepareFile (std::string const& file_name, std::int64_t nbytes)
+{
+    // If the file is written again, the jobs of all processes writing the
+    // earlier version must finish before it is truncated.  The processes of
+    // a file prepare the same files, so they all take this branch.
+    if (!s_prepared_files.insert(file_name).second) {
+        Finish();
+#ifdef AMREX_USE_MPI
+        if (s_comm != MPI_COMM_NULL) MPI_Barrier(s_comm);
+#endif
+    }
+
+    if (s_info.ispot == 0) {
+        std::ofstream ofs(file_name.c_str(), std::ios::binary | std::ios::trunc);
+        if (!ofs.good()) amrex::FileOpenFailed(file_name);
+    }
+
+    std::int64_t offset = 0;
+#ifdef AMREX_USE_MPI
+    // The first process in the file has entered the scan, so the file exists
+    // when this returns.
+    if (s_comm != MPI_COMM_NULL) {
+        MPI_Exscan(&nbytes, &offset, 1, MPI_INT64_T, MPI_SUM, s_comm);
+        if (s_info.ispot == 0) offset = 0; // undefined on the first process
+    }
+#else
+    amrex::ignore_unused(nbytes);
+#endif
+    return offset;
+}
+
+void OpenAt (std::ofstream& ofs, std::string const& file_name, std::int64_t offset)
+{
+    ofs.open(file_name.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    if (!ofs.good()) amrex::FileOpenFailed(file_name);
+    ofs.seekp(offset, std::ios::beg);
+}
+
+void Reserve (std::int64_t nbytes)
+{
+    BL_PROFILE("AsyncOut::Reserve()");
+    std::unique_lock<std::mutex> lck(s_bytes_mutex);
+    if (s_max_bytes > 0) {
+        // A snapshot larger than the limit is let through once everything
+        // before it has been written.
+        s_bytes_cond.wait(lck, [=] () -> bool {
+            return s_bytes_in_flight == 0 || s_bytes_in_flight + nbytes <= s_max_bytes;
+        });
+    }
+    s_bytes_in_flight += nbytes;
+}
+
+void Release (std::int64_t nbytes)
+{
+    {
+        std::lock_guard<std::mutex> lck(s_bytes_mutex);
+        s_bytes_in_flight -= nbytes;
+    }
+    s_bytes_cond.notify_all();
+}
+
 void Wait ()
 {
 #ifdef AMREX_USE_MPI
@@ -3,6 +3,7 @@
 #ifdef BL_PROFILING
 
 #include <AMReX_BLProfiler.H>
+#include <AMReX_EventTrace.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -354,6 +355,7 @@ void BLProfiler::stop() {
 {
   double tDiff(amrex::second() - bltstart);
   double nestedTime(0.0);
+  EventTrace::Complete(fname, bltstart, bltstart + tDiff);
   bltelapsed += tDiff;
   bRunning = false;
   Real thisFuncTime(bltelapsed);
@@ -432,6 +434,9 @@ void BLProfiler::RegionStart(const std::string &rname) {
   if(inNRegions == 1) {
     RegionStop(noRegionName);
   }
+  if(rname != noRegionName) {
+    EventTrace::Begin(rname);
+  }
 
   int rnameNumber;
   std::map<std::string, int>::iterator it = BLProfiler::mRegionNameNumbers.find(rname);
@@ -461,6 +466,7 @@ void BLProfiler::RegionStop(const std::string &rname) {
   rStartStop.push_back(RStartStop(rsTime, rnameNumber, false));
 
   if(rname != noRegionName) {
+    EventTrace::End(rname);
     --inNRegions;
   }
   if(inNRegions == 0) {
@@ -37,6 +37,7 @@ namespace amrex {
     int    sfc_threshold;
     Real   max_efficiency;
     int    node_size;
+    int    halo_ngrow;
 
 // We default to SFC.
 DistributionMapping::Strategy DistributionMapping::m_Strategy = DistributionMapping::SFC;
@@ -74,6 +75,12 @@ DistributionMapping::strategy (DistributionMapping::Strategy how)
     case RRSFC:
         m_BuildMap = &DistributionMapping::RRSFCProcessorMap;
         break;
+    case RCB:
+        m_BuildMap = &DistributionMapping::RCBProcessorMap;
+        break;
+    case GRAPH:
+        m_BuildMap = &DistributionMapping::GraphProcessorMap;
+        break;
     default:
         amrex::Error("Bad DistributionMapping::Strategy");
     }
@@ -114,6 +121,7 @@ DistributionMapping::Initialize ()
     sfc_threshold    = 0;
     max_efficiency   = 0.9_rt;
     node_size        = 0;
+    halo_ngrow       = 1;
     flag_verbose_mapper = 0;
 
     ParmParse pp("DistributionMapping");
@@ -123,6 +131,7 @@ DistributionMapping::Initialize ()
     pp.query("efficiency",          max_efficiency);
     pp.query("sfc_threshold",       sfc_threshold);
     pp.query("node_size",           node_size);
+    pp.query("halo_ngrow",          halo_ngrow);
     pp.query("verbose_mapper",      flag_verbose_mapper);
 
     std::string theStrategy;
@@ -145,6 +154,14 @@ DistributionMapping::Initialize ()
         {
             strategy(RRSFC);
         }
+        else if (theStrategy == "RCB")
+        {
+            strategy(RCB);
+        }
+        else if (theStrategy == "GRAPH")
+        {
+            strategy(GRAPH);
+        }
         else
         {
             std::string msg("Unknown strategy: ");
@@ -1397,6 +1414,613 @@ DistributionMapping::RRSFCProcessorMap (const BoxArray&          boxes,
     RRSFCDoIt(boxes,nprocs);
 }
 
+namespace {
+
+    // Halo exchange graph of a BoxArray.  Two boxes are connected if either
+    // is within ngrow cells of the other, and the edge is weighted by the
+    // number of cells a FillBoundary with ngrow ghost cells copies between
+    // them in both directions.  Periodic images are ignored.
+    struct BoxGraph
+    {
+        int nvertices () const noexcept { return static_cast<int>(vwgt.size()); }
+        Vector<Long> vwgt;
+        Vector<int>  xadj;
+        Vector<int>  adj;
+        Vector<Long> ewgt;
+    };
+
+    BoxGraph
+    makeBoxGraph (const BoxArray& boxes, const std::vector<Long>& wgts, const IntVect& ngrow)
+    {
+        BL_PROFILE("makeBoxGraph()");
+
+        BoxArray ba = boxes;
+        ba.convert(IndexType::TheCellType());
+        const int N = ba.size();
+
+        std::vector<std::pair<std::pair<int,int>,Long> > edges;
+        std::vector<std::pair<int,Box> > isects;
+        for (int i = 0; i < N; ++i)
+        {
+            ba.intersections(amrex::grow(ba[i],ngrow), isects);
+            for (auto const& is : isects)
+            {
+                const int j = is.first;
+                if (j != i) {
+                    edges.push_back({{std::min(i,j),std::max(i,j)}, is.second.numPts()});
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        BoxGraph g;
+        g.vwgt.assign(wgts.begin(), wgts.end());
+        Vector<int> degree(N, 0);
+        Vector<std::pair<std::pair<int,int>,Long> > uedges;
+        for (auto const& e : edges)
+        {
+            if (!uedges.empty() && uedges.back().first == e.first) {
+                uedges.back().second += e.second;
+            } else {
+                uedges.push_back(e);
+                ++degree[e.first.first];
+                ++degree[e.first.second];
+            }
+        }
+        g.xadj.resize(N+1, 0);
+        for (int i = 0; i < N; ++i) {
+            g.xadj[i+1] = g.xadj[i] + degree[i];
+        }
+        g.adj.resize(g.xadj[N]);
+        g.ewgt.resize(g.xadj[N]);
+        Vector<int> pos(g.xadj.begin(), g.xadj.end()-1);
+        for (auto const& e : uedges)
+        {
+            const int i = e.first.first, j = e.first.second;
+            g.adj[pos[i]] = j;  g.ewgt[pos[i]++] = e.second;
+            g.adj[pos[j]] = i;  g.ewgt[pos[j]++] = e.second;
+        }
+        return g;
+    }
+
+    Long
+    cutWeight (const BoxGraph& g, const Vector<int>& part)
+    {
+        Long cut = 0;
+        for (int v = 0, N = g.nvertices(); v < N; ++v) {
+            for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                if (part[v] != part[g.adj[e]]) cut += g.ewgt[e];
+            }
+        }
+        return cut/2;
+    }
+
+    //
+    // Recursive coordinate bisection: split the boxes at the median weight
+    // along the longest extent of their centers, and the processes in
+    // proportion, until each part has one process.
+    //
+    void
+    rcb (Vector<int>& ids, int begin, int end, const Vector<IntVect>& ctr,
+         const std::vector<Long>& wgts, int p0, int np, Vector<int>& owner)
+    {
+        if (np == 1 || end-begin <= 1)
+        {
+            for (int k = begin; k < end; ++k) owner[ids[k]] = p0;
+            return;
+        }
+
+        IntVect lo = ctr[ids[begin]], hi = lo;
+        Long wtot = 0;
+        for (int k = begin; k < end; ++k) {
+            lo.min(ctr[ids[k]]);
+            hi.max(ctr[ids[k]]);
+            wtot += wgts[ids[k]];
+        }
+        const int dir = (hi-lo).maxDir(false);
+        std::sort(ids.begin()+begin, ids.begin()+end, [&] (int a, int b)
+                  { return  ctr[a][dir] <  ctr[b][dir]
+                        || (ctr[a][dir] == ctr[b][dir] && a < b); });
+
+        const int npl = np/2;
+        const Real target = Real(wtot)*npl/np;
+        Long wl = 0;
+        int cut = begin+1;
+        Real best = std::numeric_limits<Real>::max();
+        for (int k = begin; k < end-1; ++k) {
+            wl += wgts[ids[k]];
+            const Real d = std::abs(Real(wl)-target);
+            if (d < best) {
+                best = d;
+                cut = k+1;
+            }
+        }
+
+        rcb(ids, begin, cut, ctr, wgts, p0    , npl   , owner);
+        rcb(ids, cut  , end, ctr, wgts, p0+npl, np-npl, owner);
+    }
+
+    //
+    // Collapse pairs of vertices joined by the heaviest edge.  cmap maps the
+    // vertices of g to those of the returned coarse graph.
+    //
+    BoxGraph
+    coarsenGraph (const BoxGraph& g, Long maxvwgt, Vector<int>& cmap)
+    {
+        const int N = g.nvertices();
+        cmap.assign(N, -1);
+        int nc = 0;
+        for (int v = 0; v < N; ++v)
+        {
+            if (cmap[v] >= 0) continue;
+            int match = -1;
+            Long wmax = -1;
+            for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                const int u = g.adj[e];
+                if (cmap[u] < 0 && g.ewgt[e] > wmax && g.vwgt[v]+g.vwgt[u] <= maxvwgt) {
+                    wmax = g.ewgt[e];
+                    match = u;
+                }
+            }
+            cmap[v] = nc;
+            if (match >= 0) cmap[match] = nc;
+            ++nc;
+        }
+
+        BoxGraph cg;
+        cg.vwgt.assign(nc, 0);
+        for (int v = 0; v < N; ++v) {
+            cg.vwgt[cmap[v]] += g.vwgt[v];
+        }
+
+        // coarse vertex -> fine vertices, in order
+        Vector<int> cstart(nc+1, 0);
+        for (int v = 0; v < N; ++v) ++cstart[cmap[v]+1];
+        for (int c = 0; c < nc; ++c) cstart[c+1] += cstart[c];
+        Vector<int> fine(N), pos(cstart.begin(), cstart.end()-1);
+        for (int v = 0; v < N; ++v) fine[pos[cmap[v]]++] = v;
+
+        Vector<int> where(nc, -1);
+        cg.xadj.resize(nc+1, 0);
+        for (int c = 0; c < nc; ++c)
+        {
+            const int e0 = static_cast<int>(cg.adj.size());
+            for (int k = cstart[c]; k < cstart[c+1]; ++k) {
+                const int v = fine[k];
+                for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                    const int cu = cmap[g.adj[e]];
+                    if (cu == c) continue;
+                    if (where[cu] >= e0) {
+                        cg.ewgt[where[cu]] += g.ewgt[e];
+                    } else {
+                        where[cu] = static_cast<int>(cg.adj.size());
+                        cg.adj.push_back(cu);
+                        cg.ewgt.push_back(g.ewgt[e]);
+                    }
+                }
+            }
+            cg.xadj[c+1] = static_cast<int>(cg.adj.size());
+        }
+        return cg;
+    }
+
+    //
+    // Move vertices between the two parts to reduce the cut while keeping the
+    // weight of part 0 within tol of target, after first restoring the
+    // balance if it is off by more than tol.
+    //
+    void
+    refineBisection (const BoxGraph& g, Vector<int>& part, Long target, Long tol)
+    {
+        const int N = g.nvertices();
+        Long w0 = 0;
+        for (int v = 0; v < N; ++v) {
+            if (part[v] == 0) w0 += g.vwgt[v];
+        }
+
+        auto gain = [&] (int v) -> Long
+        {
+            Long ext = 0, inte = 0;
+            for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                if (part[g.adj[e]] == part[v]) {
+                    inte += g.ewgt[e];
+                } else {
+                    ext += g.ewgt[e];
+                }
+            }
+            return ext - inte;
+        };
+
+        for (int pass = 0; pass < 8; ++pass)
+        {
+            if (std::abs(w0-target) > tol)
+            {
+                const int from = (w0 > target) ? 0 : 1;
+                std::vector<std::pair<Long,int> > cand;
+                for (int v = 0; v < N; ++v) {
+                    if (part[v] == from) cand.push_back({-gain(v), v});
+                }
+                std::sort(cand.begin(), cand.end());
+                for (auto const& c : cand)
+                {
+                    const Long excess = std::abs(w0-target);
+                    if (excess <= tol) break;
+                    const int v = c.second;
+                    if (g.vwgt[v] < 2*excess) {
+                        part[v] = 1-from;
+                        w0 += (from == 0) ? -g.vwgt[v] : g.vwgt[v];
+                    }
+                }
+            }
+
+            bool moved = false;
+            for (int v = 0; v < N; ++v)
+            {
+                if (gain(v) <= 0) continue;
+                const Long nw0 = (part[v] == 0) ? w0-g.vwgt[v] : w0+g.vwgt[v];
+                if (std::abs(nw0-target) <= std::max(tol, std::abs(w0-target))) {
+                    part[v] = 1-part[v];
+                    w0 = nw0;
+                    moved = true;
+                }
+            }
+            if (!moved) break;
+        }
+    }
+
+    //
+    // Grow part 0 from a seed vertex, always adding the neighbor most
+    // connected to it, until it holds the target weight.
+    //
+    void
+    growBisection (const BoxGraph& g, int seed, Long target, Vector<int>& part)
+    {
+        const int N = g.nvertices();
+        part.assign(N, 1);
+        Vector<Long> conn(N, 0);
+        std::priority_queue<std::pair<Long,int> > frontier;
+        frontier.push({0, -seed});
+        int next = 0;
+        Long w0 = 0;
+        while (w0 < target)
+        {
+            int v = -1;
+            while (!frontier.empty() && v < 0) {
+                const auto top = frontier.top();
+                frontier.pop();
+                if (part[-top.second] == 1 && conn[-top.second] == top.first) {
+                    v = -top.second;
+                }
+            }
+            if (v < 0) {
+                // the part is not connected to the rest
+                while (next < N && part[next] == 0) ++next;
+                if (next == N) break;
+                v = next;
+            }
+            if (w0 + g.vwgt[v]/2 >= target) break;
+            part[v] = 0;
+            w0 += g.vwgt[v];
+            for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                const int u = g.adj[e];
+                if (part[u] == 1) {
+                    conn[u] += g.ewgt[e];
+                    frontier.push({conn[u], -u});
+                }
+            }
+        }
+    }
+
+    //
+    // Multilevel bisection of g with a fraction frac of its weight in part 0.
+    //
+    void
+    bisectGraph (const BoxGraph& g, Real frac, Vector<int>& part)
+    {
+        Long wtot = 0, wmax = 0;
+        for (Long w : g.vwgt) {
+            wtot += w;
+            wmax = std::max(wmax, w);
+        }
+        const Long target = static_cast<Long>(frac*wtot);
+        const Long maxvwgt = std::max(wmax, wtot/32);
+
+        Vector<BoxGraph> graphs;
+        Vector<Vector<int> > cmaps;
+        const BoxGraph* cur = &g;
+        while (cur->nvertices() > 32)
+        {
+            Vector<int> cmap;
+            BoxGraph cg = coarsenGraph(*cur, maxvwgt, cmap);
+            if (cg.nvertices() > 0.9*cur->nvertices()) break;
+            graphs.push_back(std::move(cg));
+            cmaps.push_back(std::move(cmap));
+            cur = &graphs.back();
+        }
+
+        // Try a few seeds on the coarsest graph and keep the smallest cut.
+        const int NC = cur->nvertices();
+        const int nseeds = std::min(NC, 8);
+        Long tolc = 0;
+        for (Long w : cur->vwgt) tolc = std::max(tolc, w);
+        Long bestcut = std::numeric_limits<Long>::max();
+        for (int s = 0; s < nseeds; ++s)
+        {
+            Vector<int> p;
+            growBisection(*cur, (s*NC)/nseeds, target, p);
+            refineBisection(*cur, p, target, tolc);
+            const Long cut = cutWeight(*cur, p);
+            if (cut < bestcut) {
+                bestcut = cut;
+                part = std::move(p);
+            }
+        }
+
+        // Project back to the finer graphs, refining on the way.
+        for (int lev = static_cast<int>(graphs.size())-1; lev >= 0; --lev)
+        {
+            const BoxGraph& fg = (lev == 0) ? g : graphs[lev-1];
+            Vector<int> fpart(fg.nvertices());
+            for (int v = 0; v < fg.nvertices(); ++v) {
+                fpart[v] = part[cmaps[lev][v]];
+            }
+            part = std::move(fpart);
+            Long tol = std::max(wtot/100, (lev == 0) ? wmax/2 : maxvwgt/2);
+            refineBisection(fg, part, target, tol);
+        }
+        if (graphs.empty()) {
+            refineBisection(g, part, target, std::max(wtot/100, wmax/2));
+        }
+    }
+
+    //
+    // Recursive multilevel bisection of the graph over np processes starting
+    // at p0.  ids maps the vertices of g to the boxes.
+    //
+    void
+    partitionGraph (const BoxGraph& g, const Vector<int>& ids, int p0, int np,
+                    Vector<int>& owner)
+    {
+        const int N = g.nvertices();
+        if (np == 1 || N <= 1)
+        {
+            for (int v = 0; v < N; ++v) owner[ids[v]] = p0;
+            return;
+        }
+
+        const int npl = np/2;
+        Vector<int> part;
+        bisectGraph(g, Real(npl)/np, part);
+
+        for (int side = 0; side < 2; ++side)
+        {
+            Vector<int> local(N, -1);
+            Vector<int> sids;
+            BoxGraph sg;
+            for (int v = 0; v < N; ++v) {
+                if (part[v] == side) {
+                    local[v] = static_cast<int>(sids.size());
+                    sids.push_back(ids[v]);
+                    sg.vwgt.push_back(g.vwgt[v]);
+                }
+            }
+            sg.xadj.push_back(0);
+            for (int v = 0; v < N; ++v) {
+                if (part[v] != side) continue;
+                for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                    if (local[g.adj[e]] >= 0) {
+                        sg.adj.push_back(local[g.adj[e]]);
+                        sg.ewgt.push_back(g.ewgt[e]);
+                    }
+                }
+                sg.xadj.push_back(static_cast<int>(sg.adj.size()));
+            }
+            if (side == 0) {
+                partitionGraph(sg, sids, p0, npl, owner);
+            } else {
+                partitionGraph(sg, sids, p0+npl, np-npl, owner);
+            }
+        }
+    }
+
+    //
+    // Move boxes off the most loaded process until it is within 1% of the
+    // average, preferably to processes they exchange ghost cells with and at
+    // the smallest increase of the cut.  Every move lowers the larger of the
+    // two loads involved.
+    //
+    void
+    balancePartition (const BoxGraph& g, int nprocs, Vector<int>& owner)
+    {
+        const int N = g.nvertices();
+        Vector<Long> load(nprocs, 0);
+        Vector<Vector<int> > members(nprocs);
+        Long wtot = 0;
+        for (int v = 0; v < N; ++v) {
+            load[owner[v]] += g.vwgt[v];
+            members[owner[v]].push_back(v);
+            wtot += g.vwgt[v];
+        }
+        const Real limit = 1.01_rt*Real(wtot)/nprocs;
+
+        Vector<Long> conn(nprocs, 0);
+        for (int iter = 0; iter < N; ++iter)
+        {
+            const int p = static_cast<int>(std::max_element(load.begin(), load.end())
+                                           - load.begin());
+            if (load[p] <= limit) break;
+            const int qmin = static_cast<int>(std::min_element(load.begin(), load.end())
+                                              - load.begin());
+
+            int bestv = -1, bestq = -1;
+            Long bestcost = std::numeric_limits<Long>::max();
+            for (int v : members[p])
+            {
+                for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                    conn[owner[g.adj[e]]] += g.ewgt[e];
+                }
+                auto consider = [&] (int q)
+                {
+                    if (q != p && load[q] + g.vwgt[v] < load[p]) {
+                        const Long cost = conn[p] - conn[q];
+                        if (cost < bestcost || (cost == bestcost && load[q] < load[bestq])) {
+                            bestcost = cost;
+                            bestv = v;
+                            bestq = q;
+                        }
+                    }
+                };
+                for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                    consider(owner[g.adj[e]]);
+                }
+                consider(qmin);
+                for (int e = g.xadj[v]; e < g.xadj[v+1]; ++e) {
+                    conn[owner[g.adj[e]]] = 0;
+                }
+            }
+            if (bestv < 0) break;
+
+            owner[bestv] = bestq;
+            load[p] -= g.vwgt[bestv];
+            load[bestq] += g.vwgt[bestv];
+            members[p].erase(std::find(members[p].begin(), members[p].end(), bestv));
+            members[bestq].push_back(bestv);
+        }
+    }
+
+    Real
+    partitionEfficiency (const Vector<int>& owner, const std::vector<Long>& wgts, int nprocs)
+    {
+        Vector<Long> wproc(nprocs, 0);
+        for (int i = 0, N = owner.size(); i < N; ++i) {
+            wproc[owner[i]] += wgts[i];
+        }
+        Real sum_wgt = 0, max_wgt = 0;
+        for (Long w : wproc) {
+            sum_wgt += w;
+            max_wgt = std::max(max_wgt, Real(w));
+        }
+        return (max_wgt > 0) ? sum_wgt/(nprocs*max_wgt) : Real(1.0);
+    }
+}
+
+void
+DistributionMapping::RCBProcessorMap (const BoxArray&          boxes,
+                                      const std::vector<Long>& wgts,
+                                      int                      nprocs,
+                                      Real*                    eff)
+{
+    BL_PROFILE("DistributionMapping::RCBProcessorMap()");
+
+    BL_ASSERT(boxes.size() > 0);
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(wgts.size());
+
+    const int N = boxes.size();
+    Vector<IntVect> ctr(N);
+    Vector<int> ids(N);
+    for (int i = 0; i < N; ++i) {
+        const Box bx = boxes[i];
+        ctr[i] = bx.smallEnd() + bx.bigEnd();
+        ids[i] = i;
+    }
+
+    Vector<int> owner(N);
+    rcb(ids, 0, N, ctr, wgts, 0, nprocs, owner);
+
+    for (int i = 0; i < N; ++i) {
+        m_ref->m_pmap[i] = ParallelContext::local_to_global_rank(owner[i]);
+    }
+
+    if (eff || verbose)
+    {
+        Real efficiency = partitionEfficiency(owner, wgts, nprocs);
+        if (eff) *eff = efficiency;
+
+        if (verbose)
+        {
+            amrex::Print() << "RCB efficiency: " << efficiency
+                           << ", communication volume: "
+                           << CommunicationVolume(boxes, *this, IntVect(halo_ngrow)) << '\n';
+        }
+    }
+}
+
+void
+DistributionMapping::RCBProcessorMap (const BoxArray& boxes,
+                                      int             nprocs)
+{
+    std::vector<Long> wgts;
+    wgts.reserve(boxes.size());
+    for (int i = 0, N = boxes.size(); i < N; ++i) {
+        wgts.push_back(boxes[i].numPts());
+    }
+    RCBProcessorMap(boxes, wgts, nprocs);
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray&          boxes,
+                                        const std::vector<Long>& wgts,
+                                        int                      nprocs,
+                                        Real*                    eff)
+{
+    BL_PROFILE("DistributionMapping::GraphProcessorMap()");
+
+    BL_ASSERT(boxes.size() > 0);
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(wgts.size());
+
+    const int N = boxes.size();
+    BoxGraph g = makeBoxGraph(boxes, wgts, IntVect(halo_ngrow));
+    Vector<int> ids(N);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    Vector<int> owner(N);
+    partitionGraph(g, ids, 0, nprocs, owner);
+    balancePartition(g, nprocs, owner);
+
+    for (int i = 0; i < N; ++i) {
+        m_ref->m_pmap[i] = ParallelContext::local_to_global_rank(owner[i]);
+    }
+
+    if (eff || verbose)
+    {
+        Real efficiency = partitionEfficiency(owner, wgts, nprocs);
+        if (eff) *eff = efficiency;
+
+        if (verbose)
+        {
+            amrex::Print() << "GRAPH efficiency: " << efficiency
+                           << ", communication volume: " << cutWeight(g, owner) << '\n';
+        }
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray& boxes,
+                                        int             nprocs)
+{
+    std::vector<Long> wgts;
+    wgts.reserve(boxes.size());
+    for (int i = 0, N = boxes.size(); i < N; ++i) {
+        wgts.push_back(boxes[i].numPts());
+    }
+    GraphProcessorMap(boxes, wgts, nprocs);
+}
+
+Long
+DistributionMapping::CommunicationVolume (const BoxArray&            ba,
+                                          const DistributionMapping& dm,
+                                          const IntVect&             ngrow)
+{
+    BoxGraph g = makeBoxGraph(ba, std::vector<Long>(ba.size(), 1L), ngrow);
+    return cutWeight(g, dm.ProcessorMap());
+}
+
 DistributionMapping
 DistributionMapping::makeKnapSack (const Vector<Real>& rcost, int nmax)
 {
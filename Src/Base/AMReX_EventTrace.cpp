@@ -0,0 +1,320 @@
+#include <AMReX_EventTrace.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+#include <AMReX.H>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace amrex {
+namespace EventTrace {
+
+namespace detail { bool s_enabled = false; }
+
+namespace {
+
+struct Event
+{
+    double ts;
+    double dur;
+    std::int64_t bytes;
+    int name;
+    char ph;
+};
+
+// Only the owning thread writes to its buffer, so recording needs no lock
+// once the buffer exists.
+struct ThreadBuffer
+{
+    int tid = 0;
+    std::uint64_t count = 0;
+    std::vector<Event> events;
+    std::unordered_map<std::string,int> name_cache;
+    std::unordered_map<const char*,int> ptr_cache;
+};
+
+int s_buffer_size = 65536;
+std::string s_file = "amrex_trace.json";
+double s_t0 = 0.0;
+
+std::mutex s_mutex;
+std::vector<std::unique_ptr<ThreadBuffer> > s_buffers;
+std::vector<std::string> s_names;
+std::unordered_map<std::string,int> s_name_ids;
+
+// Bumped by Finalize so that the threads drop their pointers to the freed
+// buffers if amrex is initialized again.
+int s_generation = 0;
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+thread_local int t_generation = -1;
+
+ThreadBuffer& getBuffer ()
+{
+    if (t_buffer == nullptr || t_generation != s_generation) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        t_generation = s_generation;
+        s_buffers.push_back(std::make_unique<ThreadBuffer>());
+        t_buffer = s_buffers.back().get();
+        t_buffer->tid = static_cast<int>(s_buffers.size()) - 1;
+        t_buffer->events.resize(s_buffer_size);
+    }
+    return *t_buffer;
+}
+
+int internName (std::string const& name)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_name_ids.find(name);
+    if (it != s_name_ids.end()) {
+        return it->second;
+    } else {
+        const int id = static_cast<int>(s_names.size());
+        s_names.push_back(name);
+        s_name_ids.emplace(name, id);
+        return id;
+    }
+}
+
+int nameId (ThreadBuffer& buf, std::string const& name)
+{
+    auto it = buf.name_cache.find(name);
+    if (it != buf.name_cache.end()) {
+        return it->second;
+    } else {
+        const int id = internName(name);
+        buf.name_cache.emplace(name, id);
+        return id;
+    }
+}
+
+int nameId (ThreadBuffer& buf, const char* name)
+{
+    auto it = buf.ptr_cache.find(name);
+    if (it != buf.ptr_cache.end()) {
+        return it->second;
+    } else {
+        const int id = internName(std::string(name));
+        buf.ptr_cache.emplace(name, id);
+        return id;
+    }
+}
+
+void record (ThreadBuffer& buf, int name, char ph, double ts, double dur, std::int64_t bytes)
+{
+    Event& e = buf.events[buf.count % buf.events.size()];
+    e.ts = ts - s_t0;
+    e.dur = dur;
+    e.bytes = bytes;
+    e.name = name;
+    e.ph = ph;
+    ++buf.count;
+}
+
+void escape (std::string& out, std::string const& s)
+{
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char tmp[8];
+            std::snprintf(tmp, sizeof(tmp), "\\u%04x", static_cast<unsigned>(c));
+            out += tmp;
+        } else {
+            out += c;
+        }
+    }
+}
+
+}
+
+void Initialize ()
+{
+    int trace = 0;
+    ParmParse pp("amrex");
+    pp.query("trace_events", trace);
+    pp.query("trace_buffer_size", s_buffer_size);
+    pp.query("trace_file", s_file);
+    s_buffer_size = std::max(s_buffer_size, 1);
+
+    if (trace) {
+        // The clocks of the processes are lined up at this barrier.
+        ParallelDescriptor::Barrier();
+        s_t0 = amrex::second();
+        getBuffer(); // so that the main thread is thread 0
+        detail::s_enabled = true;
+    }
+
+    ExecOnFinalize(Finalize);
+}
+
+void Finalize ()
+{
+    if (Enabled()) {
+        Write(s_file);
+        if (ParallelDescriptor::IOProcessor()) {
+            amrex::Print() << "EventTrace: wrote " << s_file << "\n";
+        }
+    }
+    detail::s_enabled = false;
+    s_buffers.clear();
+    s_names.clear();
+    s_name_ids.clear();
+    t_buffer = nullptr;
+    ++s_generation;
+}
+
+double Now () noexcept
+{
+    return amrex::second();
+}
+
+void Complete (const char* name, double t0, double t1, std::int64_t bytes)
+{
+    if (!Enabled()) return;
+    auto& buf = getBuffer();
+    record(buf, nameId(buf, name), 'X', t0, t1-t0, bytes);
+}
+
+void Complete (std::string const& name, double t0, double t1, std::int64_t bytes)
+{
+    if (!Enabled()) return;
+    auto& buf = getBuffer();
+    record(buf, nameId(buf, name), 'X', t0, t1-t0, bytes);
+}
+
+void Begin (std::string const& name)
+{
+    if (!Enabled()) return;
+    auto& buf = getBuffer();
+    record(buf, nameId(buf, name), 'B', Now(), 0.0, -1);
+}
+
+void End (std::string const& name)
+{
+    if (!Enabled()) return;
+    auto& buf = getBuffer();
+    record(buf, nameId(buf, name), 'E', Now(), 0.0, -1);
+}
+
+void Write (std::string const& file_name)
+{
+    // Nothing is recorded while writing, not even the MPI calls made here.
+    const bool was_enabled = detail::s_enabled;
+    detail::s_enabled = false;
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    std::string out;
+    char line[256];
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+
+        out.reserve(128 * s_buffers.size() * std::min<std::size_t>(s_buffer_size, 65536));
+        std::snprintf(line, sizeof(line),
+                      "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}},\n",
+                      myproc, myproc);
+        out += line;
+        if (myproc != nprocs-1) {
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"sort_index\":%d}},\n",
+                          myproc, myproc);
+            out += line;
+        }
+
+        for (auto const& pbuf : s_buffers)
+        {
+            auto const& buf = *pbuf;
+            const std::uint64_t cap = buf.events.size();
+            const std::uint64_t dropped = (buf.count > cap) ? buf.count - cap : 0;
+
+            std::string tname = (buf.tid == 0) ? std::string("main") : "thread " + std::to_string(buf.tid);
+            if (dropped > 0) {
+                tname += " (" + std::to_string(dropped) + " earlier events dropped)";
+            }
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+                          myproc, buf.tid, tname.c_str());
+            out += line;
+
+            const std::uint64_t n = std::min(buf.count, cap);
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                Event const& e = buf.events[(dropped+i) % cap];
+                out += "{\"name\":\"";
+                escape(out, s_names[e.name]);
+                std::snprintf(line, sizeof(line), "\",\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f",
+                              e.ph, myproc, buf.tid, e.ts*1.e6);
+                out += line;
+                if (e.ph == 'X') {
+                    std::snprintf(line, sizeof(line), ",\"dur\":%.3f", e.dur*1.e6);
+                    out += line;
+                }
+                if (e.bytes >= 0) {
+                    std::snprintf(line, sizeof(line), ",\"args\":{\"bytes\":%lld}",
+                                  static_cast<long long>(e.bytes));
+                    out += line;
+                }
+                out += "},\n";
+            }
+        }
+
+        if (myproc == nprocs-1) {
+            // The last entry must not be followed by a comma.
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"sort_index\":%d}}\n"
+                          "],\n\"displayTimeUnit\":\"ms\"}\n",
+                          myproc, myproc);
+            out += line;
+        }
+    }
+
+    // The processes append their parts in order, passing a token along.
+#ifdef BL_USE_MPI
+    const int tag = ParallelDescriptor::SeqNum();
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+    int token = 0;
+    if (myproc > 0) {
+        BL_MPI_REQUIRE( MPI_Recv(&token, 1, MPI_INT, myproc-1, tag, comm, MPI_STATUS_IGNORE) );
+    }
+#endif
+
+    {
+        std::ofstream ofs;
+        if (myproc == 0) {
+            ofs.open(file_name.c_str(), std::ios::out | std::ios::trunc);
+        } else {
+            ofs.open(file_name.c_str(), std::ios::out | std::ios::app);
+        }
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(file_name);
+        }
+        if (myproc == 0) {
+            ofs << "{\"traceEvents\":[\n";
+        }
+        ofs.write(out.data(), out.size());
+        ofs.flush();
+        if (!ofs.good()) {
+            amrex::Abort("EventTrace::Write: failed to write " + file_name);
+        }
+    }
+
+#ifdef BL_USE_MPI
+    if (myproc < nprocs-1) {
+        BL_MPI_REQUIRE( MPI_Send(&token, 1, MPI_INT, myproc+1, tag, comm) );
+    }
+#endif
+
+    detail::s_enabled = was_enabled;
+}
+
+}}
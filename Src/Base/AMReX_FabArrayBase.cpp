@@ -4,10 +4,12 @@
 #include <AMReX_Utility.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_FArrayBox.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_NonLocalBC.H>
 
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
+#include <AMReX_ShmArena.H>
 
 #ifdef AMREX_USE_GPU
 #include <AMReX_MFParallelForG.H>
@@ -88,7 +90,10 @@ std::vector<std::string>                    FabArrayBase::m_region_tag;
 namespace
 {
     Arena* the_fa_arena = nullptr;
+    std::unique_ptr<ShmArena> the_shm_arena;
     bool initialized = false;
+    bool fillpatch_temp_cache = true;
+    constexpr int fillpatch_max_temps = 4; // per FPinfo
 }
 
 void
@@ -117,6 +122,7 @@ FabArrayBase::Initialize ()
     }
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
+    pp.query("fillpatch_temp_cache", fillpatch_temp_cache);
 
     if (MaxComp < 1) {
         MaxComp = 1;
@@ -132,6 +138,22 @@ FabArrayBase::Initialize ()
     the_fa_arena = The_Cpu_Arena();
 #endif
 
+#if defined(AMREX_USE_MPI) && !defined(AMREX_USE_GPU)
+    {
+        // Allocate FAB data in node shared memory so that on-node
+        // FillBoundary and ParallelCopy can copy directly from the FABs
+        // of the other ranks instead of going through MPI.
+        bool shm_comm = false;
+        Long shm_arena_size = 256L*1024L*1024L; // per rank
+        pp.query("shm_comm", shm_comm);
+        pp.query("shm_arena_size", shm_arena_size);
+        if (shm_comm && ParallelDescriptor::TeamSize() == 1 && ParallelDescriptor::NProcsNode() > 1) {
+            the_shm_arena = std::make_unique<ShmArena>(ParallelDescriptor::CommunicatorNode(),
+                                                       shm_arena_size);
+        }
+    }
+#endif
+
     amrex::ExecOnFinalize(FabArrayBase::Finalize);
 
 #ifdef AMREX_MEM_PROFILING
@@ -164,6 +186,18 @@ The_FA_Arena ()
     return the_fa_arena;
 }
 
+ShmArena*
+The_Shm_Arena ()
+{
+    return the_shm_arena.get();
+}
+
+bool
+FabArrayBase::UseShmComm () noexcept
+{
+    return the_shm_arena != nullptr;
+}
+
 FabArrayBase::FabArrayBase ()
 {
 }
@@ -262,6 +296,37 @@ FabArrayBase::CPC::bytes () const
     return cnt;
 }
 
+void
+FabArrayBase::CommMetaData::splitTagsByNode () const
+{
+    if (m_RcvTagsOnNode) return;
+
+    m_SndTagsOffNode = std::make_unique<MapOfCopyComTagContainers>();
+    m_RcvTagsOffNode = std::make_unique<MapOfCopyComTagContainers>();
+    m_RcvTagsOnNode  = std::make_unique<MapOfCopyComTagContainers>();
+
+    for (auto const& kv : *m_SndTags) {
+        if (ParallelDescriptor::NodeRank(kv.first) < 0) {
+            m_SndTagsOffNode->insert(m_SndTagsOffNode->end(), kv);
+        }
+    }
+
+    for (auto const& kv : *m_RcvTags) {
+        if (ParallelDescriptor::NodeRank(kv.first) < 0) {
+            m_RcvTagsOffNode->insert(m_RcvTagsOffNode->end(), kv);
+        } else {
+            m_RcvTagsOnNode->insert(m_RcvTagsOnNode->end(), kv);
+        }
+    }
+
+#ifdef BL_USE_MPI
+    int on_node = !m_RcvTagsOnNode->empty();
+    BL_MPI_REQUIRE( MPI_Allreduce(MPI_IN_PLACE, &on_node, 1, MPI_INT, MPI_LOR,
+                                  ParallelDescriptor::CommunicatorNode()) );
+    m_shm_on_node = on_node;
+#endif
+}
+
 Long
 FabArrayBase::FB::bytes () const
 {
@@ -1798,6 +1863,52 @@ FabArrayBase::FPinfo::FPinfo (const FabArrayBase& srcfa,
 
 FabArrayBase::FPinfo::~FPinfo ()
 {
+    BL_ASSERT(std::none_of(m_temps.begin(), m_temps.end(),
+                           [] (Temp const& t) { return t.in_use; }));
+}
+
+MultiFab*
+FabArrayBase::FPinfo::acquireTemp (bool crse, int ncomp, IndexType ixtype) const
+{
+    if (!fillpatch_temp_cache) return nullptr;
+
+    for (auto& t : m_temps) {
+        if (!t.in_use && t.crse == crse && t.mf->nComp() == ncomp && t.mf->ixType() == ixtype) {
+            t.in_use = true;
+            m_FPinfo_stats.recordTempHit();
+            return t.mf.get();
+        }
+    }
+
+    if (static_cast<int>(m_temps.size()) >= fillpatch_max_temps) return nullptr;
+
+    const BoxArray& ba = crse ? ba_crse_patch : ba_fine_patch;
+    const FabFactory<FArrayBox>& fact = crse ? *fact_crse_patch : *fact_fine_patch;
+#ifdef AMREX_MEM_PROFILING
+    m_FPinfo_stats.bytes -= sizeof(Temp) * m_temps.capacity();
+#endif
+    m_temps.push_back(Temp{std::make_unique<MultiFab>(amrex::convert(ba, ixtype), dm_patch,
+                                                      ncomp, 0, MFInfo(), fact),
+                           crse, true});
+    m_FPinfo_stats.recordTempMiss();
+#ifdef AMREX_MEM_PROFILING
+    m_FPinfo_stats.bytes += sizeof(Temp) * m_temps.capacity() + tempBytes(*m_temps.back().mf);
+    m_FPinfo_stats.bytes_hwm = std::max(m_FPinfo_stats.bytes_hwm, m_FPinfo_stats.bytes);
+#endif
+    return m_temps.back().mf.get();
+}
+
+void
+FabArrayBase::FPinfo::releaseTemp (MultiFab* mf) const
+{
+    for (auto& t : m_temps) {
+        if (t.mf.get() == mf) {
+            BL_ASSERT(t.in_use);
+            t.in_use = false;
+            return;
+        }
+    }
+    amrex::Abort("FPinfo::releaseTemp: not a temporary of this FPinfo");
 }
 
 Long
@@ -1806,6 +1917,20 @@ FabArrayBase::FPinfo::bytes () const
     Long cnt = sizeof(FabArrayBase::FPinfo);
     cnt += sizeof(Box) * (ba_crse_patch.capacity() + ba_fine_patch.capacity());
     cnt += sizeof(int) * dm_patch.capacity();
+    cnt += sizeof(Temp) * m_temps.capacity();
+    for (auto const& t : m_temps) {
+        cnt += tempBytes(*t.mf);
+    }
+    return cnt;
+}
+
+Long
+FabArrayBase::FPinfo::tempBytes (MultiFab const& mf)
+{
+    Long cnt = sizeof(MultiFab);
+    for (int li = 0; li < mf.local_size(); ++li) {
+        cnt += mf.atLocalIdx(li).nBytesOwned();
+    }
     return cnt;
 }
 
@@ -1875,6 +2000,7 @@ FabArrayBase::flushFPinfo (bool no_assertion)
     BL_ASSERT(no_assertion || getBDKey() == m_bdkey);
 
     std::vector<FPinfoCacheIter> others;
+    std::vector<FPinfo*> to_delete;
 
     std::pair<FPinfoCacheIter,FPinfoCacheIter> er_it = m_TheFillPatchCache.equal_range(m_bdkey);
 
@@ -1901,7 +2027,7 @@ FabArrayBase::flushFPinfo (bool no_assertion)
         m_FPinfo_stats.bytes -= it->second->bytes();
 #endif
         m_FPinfo_stats.recordErase(it->second->m_nuse);
-        delete it->second;
+        to_delete.push_back(it->second);
     }
 
     m_TheFillPatchCache.erase(er_it.first, er_it.second);
@@ -1911,6 +2037,12 @@ FabArrayBase::flushFPinfo (bool no_assertion)
     {
         m_TheFillPatchCache.erase(*it);
     }
+
+    // The FPinfos are deleted after they have been removed from the cache,
+    // because their temporaries flush the caches for their own grids.
+    for (FPinfo* p : to_delete) {
+        delete p;
+    }
 }
 
 FabArrayBase::CFinfo::CFinfo (const FabArrayBase& finefa,
@@ -2084,6 +2216,7 @@ FabArrayBase::Finalize ()
     m_FA_stats = FabArrayStats();
 
     the_fa_arena = nullptr;
+    the_shm_arena.reset();
 
     initialized = false;
 }
@@ -64,11 +64,28 @@ namespace amrex { namespace ParallelDescriptor {
     ProcessTeam m_Team;
 
     MPI_Comm m_comm = MPI_COMM_NULL;    // communicator for all ranks, probably MPI_COMM_WORLD
+    MPI_Comm m_comm_node = MPI_COMM_NULL; // communicator for the ranks on this node
+    Vector<int> m_node_ranks;
 
     int m_MinTag = 1000, m_MaxTag = -1;
 
     const int ioProcessor = 0;
 
+    int MyProcNode () noexcept
+    {
+        return NodeRank(MyProc());
+    }
+
+    int NodeRank (int rank) noexcept
+    {
+        auto it = std::lower_bound(m_node_ranks.begin(), m_node_ranks.end(), rank);
+        if (it != m_node_ranks.end() && *it == rank) {
+            return static_cast<int>(it - m_node_ranks.begin());
+        } else {
+            return -1;
+        }
+    }
+
 #ifdef AMREX_PMI
     void PMI_Initialize()
     {
@@ -342,6 +359,23 @@ StartParallel (int* argc, char*** argv, MPI_Comm a_mpi_comm)
     if (mpi_version < 3) amrex::Abort("MPI 3 is needed because USE_MPI3=TRUE");
 #endif
 
+    // ---- ranks that can share memory with this one
+    BL_MPI_REQUIRE( MPI_Comm_split_type(m_comm, MPI_COMM_TYPE_SHARED, MyProc(m_comm),
+                                        MPI_INFO_NULL, &m_comm_node) );
+    {
+        int nprocs_node = NProcs(m_comm_node);
+        Vector<int> lranks(nprocs_node);
+        std::iota(lranks.begin(), lranks.end(), 0);
+        m_node_ranks.resize(nprocs_node);
+        MPI_Group group_node, group;
+        BL_MPI_REQUIRE( MPI_Comm_group(m_comm_node, &group_node) );
+        BL_MPI_REQUIRE( MPI_Comm_group(m_comm, &group) );
+        BL_MPI_REQUIRE( MPI_Group_translate_ranks(group_node, nprocs_node, lranks.data(),
+                                                  group, m_node_ranks.data()) );
+        BL_MPI_REQUIRE( MPI_Group_free(&group_node) );
+        BL_MPI_REQUIRE( MPI_Group_free(&group) );
+    }
+
     // Wait until all other processes are properly started.
 //    BL_MPI_REQUIRE( MPI_Barrier(Communicator()) );
 
@@ -363,6 +397,10 @@ EndParallel ()
         mpi_type_lull_t    = MPI_DATATYPE_NULL;
     }
 
+    BL_MPI_REQUIRE( MPI_Comm_free(&m_comm_node) );
+    m_comm_node = MPI_COMM_NULL;
+    m_node_ranks.clear();
+
     if (!call_mpi_finalize) {
         BL_MPI_REQUIRE( MPI_Comm_free(&m_comm) );
     }
@@ -391,6 +429,7 @@ Barrier (const std::string &message)
 #endif
 
     BL_PROFILE_S("ParallelDescriptor::Barrier()");
+    AMREX_TRACE_SCOPE("MPI_Barrier");
     BL_COMM_PROFILE_BARRIER(message, true);
 
     BL_MPI_REQUIRE( MPI_Barrier(ParallelDescriptor::Communicator()) );
@@ -411,6 +450,7 @@ Barrier (const MPI_Comm &comm, const std::string &message)
 #endif
 
     BL_PROFILE_S("ParallelDescriptor::Barrier(comm)");
+    AMREX_TRACE_SCOPE("MPI_Barrier");
     BL_COMM_PROFILE_BARRIER(message, true);
 
     BL_MPI_REQUIRE( MPI_Barrier(comm) );
@@ -1010,6 +1050,7 @@ void
 Wait (MPI_Request& req, MPI_Status& status)
 {
     BL_PROFILE_S("ParallelDescriptor::Wait()");
+    AMREX_TRACE_SCOPE("MPI_Wait");
     BL_COMM_PROFILE_WAIT(BLProfiler::Wait, req, status, true);
     BL_MPI_REQUIRE( MPI_Wait(&req, &status) );
     BL_COMM_PROFILE_WAIT(BLProfiler::Wait, req, status, false);
@@ -1021,6 +1062,7 @@ Waitall (Vector<MPI_Request>& reqs, Vector<MPI_Status>& status)
     BL_ASSERT(status.size() >= reqs.size());
 
     BL_PROFILE_S("ParallelDescriptor::Waitall()");
+    AMREX_TRACE_SCOPE("MPI_Waitall");
     BL_COMM_PROFILE_WAITSOME(BLProfiler::Waitall, reqs, reqs.size(), status, true);
     BL_MPI_REQUIRE( MPI_Waitall(reqs.size(),
                                 reqs.dataPtr(),
@@ -1032,6 +1074,7 @@ void
 Waitany (Vector<MPI_Request>& reqs, int &index, MPI_Status& status)
 {
     BL_PROFILE_S("ParallelDescriptor::Waitany()");
+    AMREX_TRACE_SCOPE("MPI_Waitany");
     BL_COMM_PROFILE_WAIT(BLProfiler::Waitany, reqs[0], status, true);
     BL_MPI_REQUIRE( MPI_Waitany(reqs.size(),
                                 reqs.dataPtr(),
@@ -1048,6 +1091,7 @@ Waitsome (Vector<MPI_Request>& reqs, int& completed,
     BL_ASSERT(indx.size() >= reqs.size());
 
     BL_PROFILE_S("ParallelDescriptor::Waitsome()");
+    AMREX_TRACE_SCOPE("MPI_Waitsome");
     BL_COMM_PROFILE_WAITSOME(BLProfiler::Waitsome, reqs, reqs.size(), status, true);
     BL_MPI_REQUIRE( MPI_Waitsome(reqs.size(),
                                  reqs.dataPtr(),
@@ -1068,6 +1112,7 @@ Bcast(void *buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm)
 #endif
 
     BL_PROFILE_S("ParallelDescriptor::Bcast(viMiM)");
+    AMREX_TRACE_SCOPE("MPI_Bcast");
     BL_COMM_PROFILE(BLProfiler::BCastTsi, BLProfiler::BeforeCall(), root, BLProfiler::NoTag());
 
     BL_MPI_REQUIRE( MPI_Bcast(buf,
@@ -1087,6 +1132,8 @@ void
 StartParallel (int* /*argc*/, char*** /*argv*/, MPI_Comm)
 {
     m_comm = 0;
+    m_comm_node = 0;
+    m_node_ranks.assign(1, 0);
     m_MaxTag = 9000;
     ParallelContext::push(m_comm);
 }
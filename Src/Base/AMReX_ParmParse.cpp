@@ -19,6 +19,8 @@
 #include <cctype>
 #include <vector>
 #include <list>
+#include <mutex>
+#include <unordered_map>
 #include <regex>
 #include <set>
 #include <string>
@@ -70,7 +72,8 @@ ParmParse::PP_entry::PP_entry (const PP_entry& pe)
     : m_name(pe.m_name),
       m_vals(pe.m_vals),
       m_table(0),
-      m_queried(pe.m_queried)
+      m_queried(pe.m_queried),
+      m_converted(pe.m_converted)
 {
     if ( pe.m_table )
     {
@@ -91,6 +94,7 @@ ParmParse::PP_entry::operator= (const PP_entry& pe)
     m_vals = pe.m_vals;
     m_table = 0;
     m_queried = pe.m_queried;
+    m_converted = pe.m_converted;
     if ( pe.m_table )
     {
         m_table = new Table(*pe.m_table);
@@ -196,6 +200,39 @@ ParmParse::Table g_table;
 typedef std::list<ParmParse::PP_entry>::iterator list_iterator;
 typedef std::list<ParmParse::PP_entry>::const_iterator const_list_iterator;
 
+//
+// Index of g_table by name, holding the entries of each name in table order.
+// It is rebuilt by the first lookup after the table has been changed, except
+// for entries appended by add and addarr, which are indexed right away.
+// The lookups and the changes to g_table after initialization hold g_mutex.
+//
+std::unordered_map<std::string,std::vector<ParmParse::PP_entry*> > g_index;
+bool g_index_valid = false;
+std::mutex g_mutex;
+
+void
+invalidate_index ()
+{
+    g_index.clear();
+    g_index_valid = false;
+}
+
+const std::vector<ParmParse::PP_entry*>*
+ppentries (const std::string& name)
+{
+    if ( !g_index_valid )
+    {
+        g_index.clear();
+        for ( list_iterator li = g_table.begin(), End = g_table.end(); li != End; ++li )
+        {
+            g_index[li->m_name].push_back(&*li);
+        }
+        g_index_valid = true;
+    }
+    auto found = g_index.find(name);
+    return found == g_index.end() ? nullptr : &found->second;
+}
+
 template <class T> const char* tok_name(const T&) { return typeid(T).name(); }
 template <class T> const char* tok_name(std::vector<T>&) { return tok_name(T());}
 
@@ -408,6 +445,56 @@ ppindex (const ParmParse::Table& table,
 {
     const ParmParse::PP_entry* fnd = 0;
 
+    if ( &table == &g_table )
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        const std::vector<ParmParse::PP_entry*>* entries = ppentries(name);
+        if ( entries == nullptr )
+        {
+            return fnd;
+        }
+        if ( n == ParmParse::LAST )
+        {
+            for ( auto it = entries->rbegin(), REnd = entries->rend(); it != REnd; ++it )
+            {
+                if ( ppfound(name, **it, recordQ) )
+                {
+                    fnd = *it;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for ( const ParmParse::PP_entry* pe : *entries )
+            {
+                if ( ppfound(name, *pe, recordQ) )
+                {
+                    fnd = pe;
+                    if ( --n < 0 )
+                    {
+                        break;
+                    }
+                }
+            }
+            if ( n >= 0 )
+            {
+                fnd = 0;
+            }
+        }
+        if ( fnd )
+        {
+            for ( const ParmParse::PP_entry* pe : *entries )
+            {
+                if ( ppfound(name, *pe, recordQ) )
+                {
+                    pe->m_queried = true;
+                }
+            }
+        }
+        return fnd;
+    }
+
     if ( n == ParmParse::LAST )
     {
         //
@@ -457,6 +544,41 @@ ppindex (const ParmParse::Table& table,
     return fnd;
 }
 
+//
+// Return the number of occurrences of a parameter name.
+//
+
+int
+ppcount (const ParmParse::Table& table,
+         const std::string& name,
+         bool recordQ)
+{
+    int cnt = 0;
+    if ( &table == &g_table )
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if ( const std::vector<ParmParse::PP_entry*>* entries = ppentries(name) )
+        {
+            for ( const ParmParse::PP_entry* pe : *entries )
+            {
+                if ( ppfound(name, *pe, recordQ) )
+                {
+                    cnt++;
+                }
+            }
+        }
+        return cnt;
+    }
+    for ( const_list_iterator li = table.begin(), End = table.end(); li != End; ++li )
+    {
+        if ( ppfound(name, *li, recordQ) )
+        {
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
 void
 bldTable (const char*& str, std::list<ParmParse::PP_entry>& tab);
 
@@ -716,6 +838,60 @@ bldTable (const char*&                    str,
 
 namespace
 {
+template <class T>
+struct Converted
+{
+    std::vector<T>    vals;
+    std::vector<char> ok;
+};
+
+//
+// Convert value number ival of an entry to T, reusing the result of an
+// earlier conversion to the same type.
+//
+template <class T>
+bool
+convert (const ParmParse::PP_entry& def, int ival, T& val)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Converted<T>* cvt = nullptr;
+    for (auto const& c : def.m_converted)
+    {
+        if ( c.first == std::type_index(typeid(T)) )
+        {
+            cvt = static_cast<Converted<T>*>(c.second.get());
+            break;
+        }
+    }
+    if ( cvt == nullptr )
+    {
+        auto p = std::make_shared<Converted<T> >();
+        p->vals.resize(def.m_vals.size());
+        p->ok.resize(def.m_vals.size(), 0);
+        cvt = p.get();
+        def.m_converted.emplace_back(std::type_index(typeid(T)), std::move(p));
+    }
+    if ( !cvt->ok[ival] )
+    {
+        T v;
+        if ( !is(def.m_vals[ival], v) )
+        {
+            return false;
+        }
+        cvt->vals[ival] = v;
+        cvt->ok[ival] = 1;
+    }
+    val = cvt->vals[ival];
+    return true;
+}
+
+template <>
+bool
+convert (const ParmParse::PP_entry& def, int ival, std::string& val)
+{
+    return is(def.m_vals[ival], val);
+}
+
 template <class T>
 bool
 squeryval (const ParmParse::Table& table,
@@ -753,7 +929,7 @@ squeryval (const ParmParse::Table& table,
 
     const std::string& valname = def->m_vals[ival];
 
-    bool ok = is(valname, ptr);
+    bool ok = convert(*def, ival, ptr);
     if ( !ok )
     {
         amrex::ErrorStream() << "ParmParse::queryval type mismatch on value number "
@@ -854,7 +1030,7 @@ squeryarr (const ParmParse::Table& table,
     for ( int n = start_ix; n <= stop_ix; n++ )
     {
         const std::string& valname = def->m_vals[n];
-        bool ok = is(valname, ptr[n]);
+        bool ok = convert(*def, n, ptr[n]);
         if ( !ok )
         {
             amrex::ErrorStream() << "ParmParse::queryarr type mismatch on value number "
@@ -913,7 +1089,12 @@ saddval (const std::string&      name,
     val << std::setprecision(17) << ptr;
     ParmParse::PP_entry entry(name,val.str());
     entry.m_queried=true;
+    std::lock_guard<std::mutex> lock(g_mutex);
     g_table.push_back(entry);
+    if ( g_index_valid )
+    {
+        g_index[name].push_back(&g_table.back());
+    }
 }
 
 
@@ -930,7 +1111,12 @@ saddarr (const std::string&      name,
     }
     ParmParse::PP_entry entry(name,arr);
     entry.m_queried=true;
+    std::lock_guard<std::mutex> lock(g_mutex);
     g_table.push_back(entry);
+    if ( g_index_valid )
+    {
+        g_index[name].push_back(&g_table.back());
+    }
 }
 
 }
@@ -968,6 +1154,7 @@ ppinit (int argc, char** argv, const char* parfile, ParmParse::Table& table)
         //
         g_table.splice(table.end(), arg_table);
     }
+    invalidate_index();
     initialized = true;
 }
 
@@ -1072,7 +1259,9 @@ ParmParse::Frame::getPrefix () const
 void
 ParmParse::appendTable(ParmParse::Table& tab)
 {
+  std::lock_guard<std::mutex> lock(g_mutex);
   g_table.splice(g_table.end(), tab);
+  invalidate_index();
 }
 
 static
@@ -1236,6 +1425,7 @@ ParmParse::Finalize ()
       if (amrex::system::abort_on_unused_inputs) amrex::Abort("ERROR: unused ParmParse variables.");
     }
     g_table.clear();
+    invalidate_index();
 
 #if !defined(BL_NO_FORT)
     amrex_finalize_namelist();
@@ -2021,29 +2211,13 @@ ParmParse::addarr (const char* name,
 int
 ParmParse::countname (const std::string& name) const
 {
-    int cnt = 0;
-    for ( const_list_iterator li = m_table.begin(), End = m_table.end(); li != End; ++li )
-    {
-        if ( ppfound(prefixedName(name), *li, false) )
-        {
-            cnt++;
-        }
-    }
-    return cnt;
+    return ppcount(m_table, prefixedName(name), false);
 }
 
 int
 ParmParse::countRecords (const std::string& name) const
 {
-    int cnt = 0;
-    for ( const_list_iterator li = m_table.begin(), End = m_table.end(); li != End; ++li )
-    {
-        if ( ppfound(prefixedName(name), *li, true) )
-        {
-            cnt++;
-        }
-    }
-    return cnt;
+    return ppcount(m_table, prefixedName(name), true);
 }
 
 //
@@ -2053,29 +2227,19 @@ ParmParse::countRecords (const std::string& name) const
 bool
 ParmParse::contains (const char* name) const
 {
-    for ( const_list_iterator li = m_table.begin(), End = m_table.end(); li != End; ++li )
-    {
-       if ( ppfound(prefixedName(name), *li, false))
-       {
-           //
-           // Found an entry; mark all occurrences of name as used.
-           //
-           for ( const_list_iterator lli = m_table.begin(); lli != m_table.end(); ++lli )
-           {
-               if ( ppfound(prefixedName(name), *lli, false) )
-               {
-                   lli->m_queried = true;
-               }
-           }
-           return true;
-       }
-    }
-    return false;
+    //
+    // Finding an entry marks all occurrences of name as used.
+    //
+    return ppindex(m_table, LAST, prefixedName(name), false) != 0;
 }
 
 int
 ParmParse::remove (const char* name)
 {
+    std::unique_lock<std::mutex> lock(g_mutex, std::defer_lock);
+    if (&m_table == &g_table) {
+        lock.lock();
+    }
     int r = 0;
     for (auto it = m_table.begin(); it != m_table.end(); ) {
         if (ppfound(prefixedName(name), *it, false)) {
@@ -2085,6 +2249,9 @@ ParmParse::remove (const char* name)
             ++it;
         }
     }
+    if (r > 0 && &m_table == &g_table) {
+        invalidate_index();
+    }
     return r;
 }
 
@@ -2,6 +2,9 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_VisMF.H>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 
 namespace amrex {
 
@@ -123,23 +126,146 @@ PlotFileDataImpl::get (int level) noexcept
     return mf;
 }
 
-MultiFab
-PlotFileDataImpl::get (int level, std::string const& varname) noexcept
+int
+PlotFileDataImpl::varIndex (std::string const& varname) const noexcept
 {
-    MultiFab mf(m_ba[level], m_dmap[level], 1, m_ngrow[level]);
     auto r = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
     if (r == std::end(m_var_names)) {
         amrex::Abort("PlotFileDataImpl::get: varname not found "+varname);
+    }
+    return static_cast<int>(std::distance(std::begin(m_var_names), r));
+}
+
+MultiFab
+PlotFileDataImpl::get (int level, std::string const& varname) noexcept
+{
+    MultiFab mf(m_ba[level], m_dmap[level], 1, m_ngrow[level]);
+    const int icomp = varIndex(varname);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        int gid = mfi.index();
+        FArrayBox& dstfab = mf[mfi];
+        std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
+        dstfab.copy<RunOn::Host>(*srcfab);
+    }
+    return mf;
+}
+
+MultiFab
+PlotFileDataImpl::get (int level, Box const& region, Vector<std::string> const& varnames) noexcept
+{
+    Vector<int> comps;
+    if (varnames.empty()) {
+        comps.resize(m_ncomp);
+        std::iota(comps.begin(), comps.end(), 0);
     } else {
-        int icomp = std::distance(std::begin(m_var_names), r);
-        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-            int gid = mfi.index();
-            FArrayBox& dstfab = mf[mfi];
-            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
-            dstfab.copy<RunOn::Host>(*srcfab);
+        for (auto const& name : varnames) {
+            comps.push_back(varIndex(name));
+        }
+    }
+    const int ncomp = comps.size();
+
+    Box bx = region;
+    if (bx.ixType() != m_ba[level].ixType()) {
+        bx.convert(m_ba[level].ixType());
+    }
+
+    // Only the FABs intersecting the region are read, and only the
+    // requested components of them.  The returned MultiFab has the
+    // intersections as its boxes and no ghost cells.
+    std::vector<std::pair<int,Box> > isects;
+    if (bx.ok()) {
+        isects = m_ba[level].intersections(bx);
+    }
+    BoxList bl(m_ba[level].ixType());
+    Vector<int> pmap;
+    Vector<int> src_index;
+    bl.reserve(isects.size());
+    pmap.reserve(isects.size());
+    src_index.reserve(isects.size());
+    for (auto const& is : isects) {
+        bl.push_back(is.second);
+        pmap.push_back(m_dmap[level][is.first]);
+        src_index.push_back(is.first);
+    }
+
+    MultiFab mf(BoxArray(std::move(bl)), DistributionMapping(std::move(pmap)), ncomp, 0);
+
+    bool all_comps = (ncomp == m_ncomp);
+    for (int n = 0; n < ncomp && all_comps; ++n) {
+        all_comps = (comps[n] == n);
+    }
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const int gid = src_index[mfi.index()];
+        const Box& dbx = mfi.validbox();
+        FArrayBox& dstfab = mf[mfi];
+        if (all_comps) {
+            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, m_mf_name[level]));
+            dstfab.copy<RunOn::Host>(*srcfab, dbx, 0, dbx, 0, ncomp);
+        } else {
+            for (int n = 0; n < ncomp; ++n) {
+                std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, comps[n]));
+                dstfab.copy<RunOn::Host>(*srcfab, dbx, 0, dbx, n, 1);
+            }
         }
     }
     return mf;
 }
 
+MultiFab
+PlotFileDataImpl::get (int level, RealBox const& region, Vector<std::string> const& varnames) noexcept
+{
+    // The cells overlapping the region.  A region that is thin in some
+    // direction (e.g., a line or a plane) still selects one layer of cells.
+    const Box& domain = m_prob_domain[level];
+    IntVect lo, hi;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const Real dx = m_cell_size[level][idim];
+        const Real xlo = (region.lo(idim) - m_prob_lo[idim]) / dx;
+        const Real xhi = (region.hi(idim) - m_prob_lo[idim]) / dx;
+        lo[idim] = domain.smallEnd(idim) + static_cast<int>(std::floor(xlo));
+        hi[idim] = domain.smallEnd(idim) + std::max(static_cast<int>(std::ceil(xhi))-1,
+                                                    static_cast<int>(std::floor(xlo)));
+        lo[idim] = std::max(lo[idim], domain.smallEnd(idim));
+        hi[idim] = std::min(hi[idim], domain.bigEnd(idim));
+    }
+    return get(level, Box(lo,hi), varnames);
+}
+
+std::unique_ptr<FArrayBox>
+PlotFileDataImpl::getFab (int level, int gid) noexcept
+{
+    return std::unique_ptr<FArrayBox>(m_vismf[level]->readFAB(gid, m_mf_name[level]));
+}
+
+Real
+PlotFileDataImpl::min (int level, std::string const& varname) noexcept
+{
+    const int icomp = varIndex(varname);
+    // The min and max of the valid regions are usually in the VisMF
+    // header, so the data do not need to be read.
+    Real r = m_vismf[level]->min(icomp);
+    if (r == std::numeric_limits<Real>::max()) {
+        for (int i = 0, N = m_ba[level].size(); i < N; ++i) {
+            r = std::min(r, m_vismf[level]->min(i, icomp));
+        }
+    }
+    if (r != std::numeric_limits<Real>::max()) { return r; }
+    return get(level, varname).min(0);
+}
+
+Real
+PlotFileDataImpl::max (int level, std::string const& varname) noexcept
+{
+    const int icomp = varIndex(varname);
+    Real r = m_vismf[level]->max(icomp);
+    if (r == std::numeric_limits<Real>::lowest()) {
+        for (int i = 0, N = m_ba[level].size(); i < N; ++i) {
+            r = std::max(r, m_vismf[level]->max(i, icomp));
+        }
+    }
+    if (r != std::numeric_limits<Real>::lowest()) { return r; }
+    return get(level, varname).max(0);
+}
+
 }
@@ -1,6 +1,7 @@
 
 #include <AMReX_VisMF.H>
 #include <AMReX_AsyncOut.H>
+#include <AMReX_BackgroundThread.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_FPC.H>
 #include <AMReX_FabArrayUtility.H>
@@ -1231,4 +1232,54 @@ WriteSingleLevelPlotfileHDF5 (const std::string& plotfilename,
 }
 
 #endif
+
+void
+ReadAhead (int n, int nahead,
+           std::function<void(int)> const& read,
+           std::function<void(int)> const& process)
+{
+    if (n <= 0) { return; }
+
+    if (nahead <= 0) {
+        for (int i = 0; i < n; ++i) {
+            read(i);
+            process(i);
+        }
+        return;
+    }
+
+    // The jobs run in order on the background thread, and each counts
+    // itself done.  read(i+nahead+1) is submitted after process(i).
+    std::mutex mtx;
+    std::condition_variable cond;
+    int nread = 0;
+
+    BackgroundThread io;
+    auto submit = [&] (int i) {
+        io.Submit([&, i] () {
+            read(i);
+            std::lock_guard<std::mutex> lock(mtx);
+            ++nread;
+            cond.notify_one();
+        });
+    };
+
+    for (int i = 0; i < std::min(n, nahead+1); ++i) {
+        submit(i);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cond.wait(lock, [&] { return nread > i; });
+        }
+        process(i);
+        if (i+nahead+1 < n) {
+            submit(i+nahead+1);
+        }
+    }
+
+    io.Finish();
+}
+
 }
@@ -0,0 +1,171 @@
+
+#include <AMReX_ShmArena.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#include <cstdlib>
+#include <iterator>
+
+namespace amrex {
+
+ShmArena::ShmArena (MPI_Comm comm, std::size_t nbytes)
+    : m_comm(comm),
+      m_size(Arena::align(nbytes))
+{
+#ifdef AMREX_USE_MPI
+    MPI_Info info;
+    BL_MPI_REQUIRE( MPI_Info_create(&info) );
+    BL_MPI_REQUIRE( MPI_Info_set(info, "alloc_shared_noncontig", "true") );
+    BL_MPI_REQUIRE( MPI_Win_allocate_shared(m_size, 1, info, m_comm, &m_base, &m_win) );
+    BL_MPI_REQUIRE( MPI_Info_free(&info) );
+
+    const int nprocs = ParallelDescriptor::NProcs(m_comm);
+    m_segments.resize(nprocs);
+    for (int r = 0; r < nprocs; ++r) {
+        MPI_Aint sz;
+        int disp;
+        BL_MPI_REQUIRE( MPI_Win_shared_query(m_win, r, &sz, &disp, &m_segments[r]) );
+    }
+
+    // A passive target epoch for the lifetime of the window so that
+    // MPI_Win_sync can be used to synchronize the public and private copies.
+    BL_MPI_REQUIRE( MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win) );
+#else
+    m_base = static_cast<char*>(std::malloc(m_size));
+    m_segments.push_back(m_base);
+#endif
+
+    if (m_size > 0) {
+        m_freelist[0] = m_size;
+    }
+}
+
+ShmArena::~ShmArena ()
+{
+#ifdef AMREX_USE_MPI
+    MPI_Win_unlock_all(m_win);
+    MPI_Win_free(&m_win);
+#else
+    std::free(m_base);
+#endif
+}
+
+void*
+ShmArena::alloc (std::size_t nbytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
+
+    auto free_it = m_freelist.begin();
+    for ( ; free_it != m_freelist.end(); ++free_it) {
+        if (free_it->second >= nbytes) {
+            break;
+        }
+    }
+
+    if (free_it == m_freelist.end()) {
+        // The segment is exhausted.  Data allocated here are not visible to
+        // the other ranks, which is detected by the callers with owns().
+        return std::malloc(nbytes);
+    }
+
+    std::size_t offset = free_it->first;
+    std::size_t leftover = free_it->second - nbytes;
+    m_freelist.erase(free_it);
+    if (leftover > 0) {
+        m_freelist.emplace(offset+nbytes, leftover);
+    }
+
+    void* p = m_base + offset;
+    m_busylist.emplace(p, nbytes);
+    m_actually_used += nbytes;
+    return p;
+}
+
+void
+ShmArena::free (void* p)
+{
+    if (p == nullptr) return;
+
+    if (!owns(p)) {
+        std::free(p);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto busy_it = m_busylist.find(p);
+    if (busy_it == m_busylist.end()) {
+        amrex::Abort("ShmArena::free: unknown pointer");
+        return;
+    }
+
+    std::size_t offset = static_cast<char*>(p) - m_base;
+    std::size_t size = busy_it->second;
+    m_actually_used -= size;
+    m_busylist.erase(busy_it);
+
+    // Merge with the neighboring free blocks.
+    auto next_it = m_freelist.lower_bound(offset);
+    if (next_it != m_freelist.end() && offset + size == next_it->first) {
+        size += next_it->second;
+        next_it = m_freelist.erase(next_it);
+    }
+    if (next_it != m_freelist.begin()) {
+        auto prev_it = std::prev(next_it);
+        if (prev_it->first + prev_it->second == offset) {
+            prev_it->second += size;
+            return;
+        }
+    }
+    m_freelist.emplace_hint(next_it, offset, size);
+}
+
+bool
+ShmArena::owns (void const* p) const noexcept
+{
+    char const* cp = static_cast<char const*>(p);
+    return cp >= m_base && cp < m_base + m_size;
+}
+
+void
+ShmArena::sync ()
+{
+#ifdef AMREX_USE_MPI
+    BL_MPI_REQUIRE( MPI_Win_sync(m_win) );
+    BL_MPI_REQUIRE( MPI_Barrier(m_comm) );
+    BL_MPI_REQUIRE( MPI_Win_sync(m_win) );
+#endif
+}
+
+bool
+ShmArena::isDeviceAccessible () const
+{
+    return false;
+}
+
+bool
+ShmArena::isHostAccessible () const
+{
+    return true;
+}
+
+bool
+ShmArena::isManaged () const
+{
+    return false;
+}
+
+bool
+ShmArena::isDevice () const
+{
+    return false;
+}
+
+bool
+ShmArena::isPinned () const
+{
+    return false;
+}
+
+}
@@ -0,0 +1,225 @@
+
+#include <AMReX_TimeIntegrator.H>
+#include <AMReX_ParmParse.H>
+
+namespace amrex {
+
+RKTableau
+RKTableau::make (std::string const& name)
+{
+    RKTableau t;
+    t.name = name;
+
+    if (name == "ForwardEuler")
+    {
+        t.order = 1;
+        t.c = {0.};
+        t.a = {{}};
+        t.b = {1.};
+    }
+    else if (name == "Trapezoid")
+    {
+        t.order = 2;
+        t.c = {0., 1.};
+        t.a = {{}, {1.}};
+        t.b = {0.5, 0.5};
+    }
+    else if (name == "SSPRK3")
+    {
+        t.order = 3;
+        t.c = {0., 1., 0.5};
+        t.a = {{}, {1.}, {0.25, 0.25}};
+        t.b = {1./6., 1./6., 2./3.};
+    }
+    else if (name == "RK4")
+    {
+        t.order = 4;
+        t.c = {0., 0.5, 0.5, 1.};
+        t.a = {{}, {0.5}, {0., 0.5}, {0., 0., 1.}};
+        t.b = {1./6., 1./3., 1./3., 1./6.};
+    }
+    else if (name == "HeunEuler")
+    {
+        t.order = 2;
+        t.embedded_order = 1;
+        t.c = {0., 1.};
+        t.a = {{}, {1.}};
+        t.b = {0.5, 0.5};
+        t.bhat = {1., 0.};
+    }
+    else if (name == "BogackiShampine")
+    {
+        t.order = 3;
+        t.embedded_order = 2;
+        t.c = {0., 0.5, 0.75, 1.};
+        t.a = {{}, {0.5}, {0., 0.75}, {2./9., 1./3., 4./9.}};
+        t.b = {2./9., 1./3., 4./9., 0.};
+        t.bhat = {7./24., 0.25, 1./3., 0.125};
+    }
+    else if (name == "DormandPrince")
+    {
+        t.order = 5;
+        t.embedded_order = 4;
+        t.c = {0., 0.2, 0.3, 0.8, 8./9., 1., 1.};
+        t.a = {{},
+               {0.2},
+               {3./40., 9./40.},
+               {44./45., -56./15., 32./9.},
+               {19372./6561., -25360./2187., 64448./6561., -212./729.},
+               {9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.},
+               {35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.}};
+        t.b = {35./384., 0., 500./1113., 125./192., -2187./6784., 11./84., 0.};
+        t.bhat = {5179./57600., 0., 7571./16695., 393./640., -92097./339200.,
+                  187./2100., 1./40.};
+    }
+    else if (name == "Williamson3")
+    {
+        t.form = Form::LowStorage2N;
+        t.order = 3;
+        t.c = {0., 1./3., 0.75};
+        t.A = {0., -5./9., -153./128.};
+        t.B = {1./3., 15./16., 8./15.};
+    }
+    else if (name == "CarpenterKennedy4")
+    {
+        t.form = Form::LowStorage2N;
+        t.order = 4;
+        t.c = {0.,
+               1432997174477./9575080441755.,
+               2526269341429./6820363962896.,
+               2006345519317./3224310063776.,
+               2802321613138./2924317926251.};
+        t.A = {0.,
+               -567301805773./1357537059087.,
+               -2404267990393./2016746695238.,
+               -3550918686646./2091501179385.,
+               -1275806237668./842570457699.};
+        t.B = {1432997174477./9575080441755.,
+               5161836677717./13612068292357.,
+               1720146321549./2090206949498.,
+               3134564353537./4481467310338.,
+               2277821191437./14882151754819.};
+    }
+    else if (name == "SSPRK3_3Sstar")
+    {
+        // Shu-Osher SSPRK3 with 2*u2 - u_n as the embedded second order
+        // solution.
+        t.form = Form::LowStorage3Sstar;
+        t.order = 3;
+        t.embedded_order = 2;
+        t.c = {0., 1., 0.5};
+        t.gamma1 = {1., 0.25, 2./3.};
+        t.gamma2 = {0., 0., 0.};
+        t.gamma3 = {0., 0.75, 1./3.};
+        t.beta = {1., 0.25, 2./3.};
+        t.delta = {0., 0., 2., 0., -1.};
+    }
+    else
+    {
+        amrex::Abort("RKTableau::make: unknown method " + name);
+    }
+
+    return t;
+}
+
+RKTableau
+RKTableau::fromParmParse (std::string const& prefix)
+{
+    ParmParse pp(prefix);
+    std::string type = "RK4";
+    pp.query("type", type);
+
+    if (type != "User") {
+        return make(type);
+    }
+
+    RKTableau t;
+    t.name = type;
+    std::string form;
+    pp.get("form", form);
+    pp.get("order", t.order);
+    pp.query("embedded_order", t.embedded_order);
+    pp.getarr("c", t.c);
+    const int m = t.nstages();
+
+    if (form == "Butcher")
+    {
+        t.form = Form::Butcher;
+        Vector<Real> a;
+        if (m > 1) { pp.getarr("a", a); }
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a.size() == m*(m-1)/2,
+                                         "RKTableau: wrong number of entries in a");
+        t.a.resize(m);
+        int ia = 0;
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < i; ++j) {
+                t.a[i].push_back(a[ia++]);
+            }
+        }
+        pp.getarr("b", t.b);
+        if (t.embedded_order > 0) {
+            pp.getarr("bhat", t.bhat);
+        }
+    }
+    else if (form == "2N")
+    {
+        t.form = Form::LowStorage2N;
+        pp.getarr("A", t.A);
+        pp.getarr("B", t.B);
+    }
+    else if (form == "3Sstar")
+    {
+        t.form = Form::LowStorage3Sstar;
+        pp.getarr("gamma1", t.gamma1);
+        pp.getarr("gamma2", t.gamma2);
+        pp.getarr("gamma3", t.gamma3);
+        pp.getarr("beta", t.beta);
+        if (t.embedded_order > 0) {
+            pp.getarr("delta", t.delta);
+        } else {
+            // delta only accumulates the embedded solution.
+            t.delta.assign(m, Real(0.));
+        }
+    }
+    else
+    {
+        amrex::Abort("RKTableau::fromParmParse: unknown form " + form);
+    }
+
+    return t;
+}
+
+void
+RKTableau::check () const
+{
+    const int m = nstages();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m > 0, "RKTableau: no stages");
+
+    switch (form) {
+    case Form::Butcher:
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a.size() == m && b.size() == m,
+                                         "RKTableau: inconsistent Butcher tableau");
+        for (int i = 0; i < m; ++i) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a[i].size() == i,
+                                             "RKTableau: the tableau must be explicit");
+        }
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!hasEmbedded() || bhat.size() == m,
+                                         "RKTableau: wrong number of embedded weights");
+        break;
+    case Form::LowStorage2N:
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(A.size() == m && B.size() == m,
+                                         "RKTableau: inconsistent 2N coefficients");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!hasEmbedded(),
+                                         "RKTableau: 2N methods have no embedded method");
+        break;
+    case Form::LowStorage3Sstar:
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(gamma1.size() == m && gamma2.size() == m &&
+                                         gamma3.size() == m && beta.size() == m,
+                                         "RKTableau: inconsistent 3S* coefficients");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(delta.size() == (hasEmbedded() ? m+2 : m),
+                                         "RKTableau: wrong number of delta coefficients");
+        break;
+    }
+}
+
+}
@@ -2,6 +2,7 @@
 // BL_PROFILE_VAR_NS, and BL_PROFILE_REGION.
 
 #include <AMReX_TinyProfiler.H>
+#include <AMReX_EventTrace.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParallelReduce.H>
 #include <AMReX_Utility.H>
@@ -160,6 +161,7 @@ TinyProfiler::stop () noexcept
             if (!uCUPTI) {
                 dtin = t - std::get<0>(tt); // elapsed time since start() is called.
                 dtex = dtin - std::get<1>(tt);
+                EventTrace::Complete(fname, std::get<0>(tt), t);
             } else {
                 dtin = t;
                 dtex = dtin - std::get<1>(tt);
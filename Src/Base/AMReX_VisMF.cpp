@@ -2361,6 +2361,19 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
     }
 #endif
 
+    // Creating the file and computing where this process writes in it are
+    // done here, so that the job does not need to talk to other processes.
+    const int64_t my_offset = AsyncOut::PrepareFile(
+        amrex::Concatenate(mf_name + FabFileSuffix, AsyncOut::GetWriteInfo(myproc).ifile, 5),
+        total_bytes);
+
+    int64_t snapshot_bytes = 0;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        Box bx = strip_ghost ? mfi.validbox() : mfi.fabbox();
+        snapshot_bytes += bx.numPts() * ncomp * sizeof(Real);
+    }
+    AsyncOut::Reserve(snapshot_bytes);
+
     auto myfabs = std::make_shared<Vector<FArrayBox> >();
     for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
         Box bx = strip_ghost ? mfi.validbox() : mfi.fabbox();
@@ -2472,16 +2485,12 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
 
         VisMF::IO_Buffer io_buffer(ioBufferSize);
 
-        AsyncOut::Wait();  // Wait for my turn
-
         auto info = AsyncOut::GetWriteInfo(myproc);
         if (! myfabs->empty()) {
             std::string file_name = amrex::Concatenate(mf_name + FabFileSuffix, info.ifile, 5);
             std::ofstream ofs;
             ofs.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
-            ofs.open(file_name.c_str(), (info.ispot == 0) ? (std::ios::binary | std::ios::trunc)
-                                                          : (std::ios::binary | std::ios::app));
-            if (!ofs.good()) amrex::FileOpenFailed(file_name);
+            AsyncOut::OpenAt(ofs, file_name, my_offset);
             for (auto const& fab : *myfabs) {
                 fabio->write_header(ofs, fab, fab.nComp());
                 fabio->write(ofs, fab, 0, fab.nComp());
@@ -2490,7 +2499,8 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
             ofs.close();
         }
 
-        AsyncOut::Notify();  // Notify others I am done
+        myfabs->clear();
+        AsyncOut::Release(snapshot_bytes);
     });
 }
 
@@ -1,5 +1,9 @@
 #include <AMReX_Parser_Exe.H>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace amrex {
 
 static int parser_local_symbol_index (struct parser_symbol* sym, Vector<char*>& local_variables)
@@ -722,4 +726,555 @@ parser_compile_exe_size (struct parser_node* node, char*& p, std::size_t& exe_si
     }
 }
 
+namespace {
+
+// Interval arithmetic for parser_exe_bounds. Operations that cannot be
+// bounded (e.g., division by an interval containing zero) give an infinite
+// interval, which is caught at the end.
+
+struct PInterval
+{
+    double lo;
+    double hi;
+};
+
+constexpr double pinf = std::numeric_limits<double>::infinity();
+constexpr double pi = 3.14159265358979323846;
+
+PInterval p_unbounded () { return {-pinf, pinf}; }
+
+bool p_has_zero (PInterval const& a) { return a.lo <= 0.0 && a.hi >= 0.0; }
+
+PInterval p_hull (PInterval const& a, PInterval const& b)
+{
+    return {std::min(a.lo,b.lo), std::max(a.hi,b.hi)};
+}
+
+// The results of libm functions are not guaranteed to be monotone to the
+// last bit, so those bounds are widened by a few ulps.
+PInterval p_widen (PInterval const& a)
+{
+    PInterval r = a;
+    for (int i = 0; i < 2; ++i) {
+        r.lo = std::nextafter(r.lo, -pinf);
+        r.hi = std::nextafter(r.hi,  pinf);
+    }
+    return r;
+}
+
+PInterval p_add (PInterval const& a, PInterval const& b) { return {a.lo+b.lo, a.hi+b.hi}; }
+
+PInterval p_sub (PInterval const& a, PInterval const& b) { return {a.lo-b.hi, a.hi-b.lo}; }
+
+PInterval p_neg (PInterval const& a) { return {-a.hi, -a.lo}; }
+
+PInterval p_mul (PInterval const& a, PInterval const& b)
+{
+    double p[] = {a.lo*b.lo, a.lo*b.hi, a.hi*b.lo, a.hi*b.hi};
+    PInterval r{p[0],p[0]};
+    for (double x : p) {
+        if (std::isnan(x)) { return p_unbounded(); } // 0*inf
+        r.lo = std::min(r.lo, x);
+        r.hi = std::max(r.hi, x);
+    }
+    return r;
+}
+
+PInterval p_div (PInterval const& a, PInterval const& b)
+{
+    if (p_has_zero(b)) { return p_unbounded(); }
+    return p_mul(a, PInterval{1.0/b.hi, 1.0/b.lo});
+}
+
+PInterval p_sqr (PInterval const& a)
+{
+    if (a.lo >= 0.0) {
+        return {a.lo*a.lo, a.hi*a.hi};
+    } else if (a.hi <= 0.0) {
+        return {a.hi*a.hi, a.lo*a.lo};
+    } else {
+        return {0.0, std::max(a.lo*a.lo, a.hi*a.hi)};
+    }
+}
+
+PInterval p_abs (PInterval const& a)
+{
+    if (a.lo >= 0.0) {
+        return a;
+    } else if (a.hi <= 0.0) {
+        return p_neg(a);
+    } else {
+        return {0.0, std::max(-a.lo, a.hi)};
+    }
+}
+
+// Does [lo,hi] contain x0 + k*period for some integer k?
+bool p_has_periodic_point (PInterval const& a, double x0, double period)
+{
+    double k = std::ceil((a.lo-x0)/period);
+    return x0 + k*period <= a.hi;
+}
+
+PInterval p_sin (PInterval const& a)
+{
+    if (!(a.hi-a.lo < 2.0*pi)) { return {-1.0, 1.0}; }
+    double s0 = std::sin(a.lo), s1 = std::sin(a.hi);
+    PInterval r{std::min(s0,s1), std::max(s0,s1)};
+    if (p_has_periodic_point(a,  0.5*pi, 2.0*pi)) { r.hi =  1.0; }
+    if (p_has_periodic_point(a, -0.5*pi, 2.0*pi)) { r.lo = -1.0; }
+    return p_widen(r);
+}
+
+PInterval p_cos (PInterval const& a)
+{
+    if (!(a.hi-a.lo < 2.0*pi)) { return {-1.0, 1.0}; }
+    double c0 = std::cos(a.lo), c1 = std::cos(a.hi);
+    PInterval r{std::min(c0,c1), std::max(c0,c1)};
+    if (p_has_periodic_point(a, 0.0, 2.0*pi)) { r.hi =  1.0; }
+    if (p_has_periodic_point(a,  pi, 2.0*pi)) { r.lo = -1.0; }
+    return p_widen(r);
+}
+
+// f is nondecreasing on [lo,hi]
+template <typename F>
+PInterval p_increasing (PInterval const& a, F const& f)
+{
+    return p_widen(PInterval{f(a.lo), f(a.hi)});
+}
+
+PInterval p_pown (PInterval const& a, int n)
+{
+    if (n == 0) {
+        return {1.0, 1.0};
+    } else if (n < 0) {
+        if (p_has_zero(a)) { return p_unbounded(); }
+        return p_div(PInterval{1.0,1.0}, p_pown(a,-n));
+    } else if (n % 2 == 0) {
+        PInterval b = p_abs(a);
+        return p_widen(PInterval{std::pow(b.lo,n), std::pow(b.hi,n)});
+    } else {
+        return p_widen(PInterval{std::pow(a.lo,n), std::pow(a.hi,n)});
+    }
+}
+
+PInterval p_f1 (parser_f1_t type, PInterval const& a)
+{
+    switch (type) {
+    case PARSER_SQRT:
+        if (a.lo < 0.0) { return p_unbounded(); }
+        return p_increasing(a, [] (double x) { return std::sqrt(x); });
+    case PARSER_EXP:
+        return p_increasing(a, [] (double x) { return std::exp(x); });
+    case PARSER_LOG:
+        if (a.lo <= 0.0) { return p_unbounded(); }
+        return p_increasing(a, [] (double x) { return std::log(x); });
+    case PARSER_LOG10:
+        if (a.lo <= 0.0) { return p_unbounded(); }
+        return p_increasing(a, [] (double x) { return std::log10(x); });
+    case PARSER_SIN:
+        return p_sin(a);
+    case PARSER_COS:
+        return p_cos(a);
+    case PARSER_TAN:
+        if (!(a.hi-a.lo < pi) || p_has_periodic_point(a, 0.5*pi, pi)) { return p_unbounded(); }
+        return p_increasing(a, [] (double x) { return std::tan(x); });
+    case PARSER_ASIN:
+        if (a.lo < -1.0 || a.hi > 1.0) { return p_unbounded(); }
+        return p_increasing(a, [] (double x) { return std::asin(x); });
+    case PARSER_ACOS:
+        if (a.lo < -1.0 || a.hi > 1.0) { return p_unbounded(); }
+        return p_widen(PInterval{std::acos(a.hi), std::acos(a.lo)});
+    case PARSER_ATAN:
+        return p_increasing(a, [] (double x) { return std::atan(x); });
+    case PARSER_SINH:
+        return p_increasing(a, [] (double x) { return std::sinh(x); });
+    case PARSER_COSH:
+    {
+        PInterval b = p_abs(a);
+        return p_increasing(b, [] (double x) { return std::cosh(x); });
+    }
+    case PARSER_TANH:
+        return p_increasing(a, [] (double x) { return std::tanh(x); });
+    case PARSER_ABS:
+        return p_abs(a);
+    case PARSER_POW_M3:
+        if (p_has_zero(a)) { return p_unbounded(); }
+        return p_div(PInterval{1.0,1.0}, p_mul(p_sqr(a),a));
+    case PARSER_POW_M2:
+        if (p_has_zero(a)) { return p_unbounded(); }
+        return p_div(PInterval{1.0,1.0}, p_sqr(a));
+    case PARSER_POW_M1:
+        return p_div(PInterval{1.0,1.0}, a);
+    case PARSER_POW_P1:
+        return a;
+    case PARSER_POW_P2:
+        return p_sqr(a);
+    case PARSER_POW_P3:
+        return p_mul(p_sqr(a),a);
+    default:
+        return p_unbounded();
+    }
+}
+
+// Result of a comparison: 1 if true for all values, 0 if false for all
+// values, and [0,1] otherwise.
+PInterval p_bool (bool always, bool never)
+{
+    if (always) {
+        return {1.0, 1.0};
+    } else if (never) {
+        return {0.0, 0.0};
+    } else {
+        return {0.0, 1.0};
+    }
+}
+
+bool p_is_zero (PInterval const& a) { return a.lo == 0.0 && a.hi == 0.0; }
+
+PInterval p_f2 (parser_f2_t type, PInterval const& a, PInterval const& b)
+{
+    switch (type) {
+    case PARSER_POW:
+    {
+        if (b.lo == b.hi && b.lo == std::floor(b.lo) && std::abs(b.lo) < 1024.) {
+            return p_pown(a, static_cast<int>(b.lo));
+        } else if (a.lo > 0.0) {
+            PInterval l = p_increasing(a, [] (double x) { return std::log(x); });
+            return p_increasing(p_mul(b,l), [] (double x) { return std::exp(x); });
+        } else {
+            return p_unbounded();
+        }
+    }
+    case PARSER_GT:
+        return p_bool(a.lo >  b.hi, a.hi <= b.lo);
+    case PARSER_LT:
+        return p_bool(a.hi <  b.lo, a.lo >= b.hi);
+    case PARSER_GEQ:
+        return p_bool(a.lo >= b.hi, a.hi <  b.lo);
+    case PARSER_LEQ:
+        return p_bool(a.hi <= b.lo, a.lo >  b.hi);
+    case PARSER_EQ:
+        return p_bool(a.lo == a.hi && b.lo == b.hi && a.lo == b.lo,
+                      a.hi < b.lo || a.lo > b.hi);
+    case PARSER_NEQ:
+        return p_bool(a.hi < b.lo || a.lo > b.hi,
+                      a.lo == a.hi && b.lo == b.hi && a.lo == b.lo);
+    case PARSER_AND:
+        return p_bool(!p_has_zero(a) && !p_has_zero(b), p_is_zero(a) || p_is_zero(b));
+    case PARSER_OR:
+        return p_bool(!p_has_zero(a) || !p_has_zero(b), p_is_zero(a) && p_is_zero(b));
+    case PARSER_HEAVISIDE:
+    {
+        if (a.lo > 0.0) {
+            return {1.0, 1.0};
+        } else if (a.hi < 0.0) {
+            return {0.0, 0.0};
+        } else {
+            PInterval r{0.0, 1.0};
+            return p_hull(r, b);
+        }
+    }
+    case PARSER_JN:
+        return {-1.0, 1.0};
+    case PARSER_MIN:
+        return {std::min(a.lo,b.lo), std::min(a.hi,b.hi)};
+    case PARSER_MAX:
+        return {std::max(a.lo,b.lo), std::max(a.hi,b.hi)};
+    default:
+        return p_unbounded();
+    }
+}
+
+struct PStack
+{
+    PInterval m_data[AMREX_PARSER_STACK_SIZE];
+    int m_size = 0;
+    void push (PInterval const& v) { m_data[m_size++] = v; }
+    void pop () { --m_size; }
+    PInterval const& top () const { return m_data[m_size-1]; }
+    PInterval      & top ()       { return m_data[m_size-1]; }
+};
+
+// Evaluates the instructions in [p,pend), or up to PARSER_EXE_NULL if
+// pend is nullptr, on intervals. This follows parser_exe_eval.
+void p_eval (char const* p, char const* pend, PInterval const* x, PStack& pstack)
+{
+#define AMREX_PARSER_GET_INTERVAL(i) ((i)>=AMREX_PARSER_LOCAL_IDX0) ? pstack.m_data[(i)-AMREX_PARSER_LOCAL_IDX0] : x[i]
+    while (p != pend && *((parser_exe_t const*)p) != PARSER_EXE_NULL) {
+        switch (*((parser_exe_t const*)p))
+        {
+        case PARSER_EXE_NUMBER:
+        {
+            double v = ((ParserExeNumber const*)p)->v;
+            pstack.push({v,v});
+            p += sizeof(ParserExeNumber);
+            break;
+        }
+        case PARSER_EXE_SYMBOL:
+        {
+            int i = ((ParserExeSymbol const*)p)->i;
+            pstack.push(AMREX_PARSER_GET_INTERVAL(i));
+            p += sizeof(ParserExeSymbol);
+            break;
+        }
+        case PARSER_EXE_ADD:
+        {
+            PInterval b = pstack.top();
+            pstack.pop();
+            pstack.top() = p_add(pstack.top(), b);
+            p += sizeof(ParserExeADD);
+            break;
+        }
+        case PARSER_EXE_SUB:
+        {
+            PInterval b = pstack.top();
+            pstack.pop();
+            pstack.top() = p_sub(pstack.top(), b);
+            if (((ParserExeSUB const*)p)->sign < 0.0) {
+                pstack.top() = p_neg(pstack.top());
+            }
+            p += sizeof(ParserExeSUB);
+            break;
+        }
+        case PARSER_EXE_MUL:
+        {
+            PInterval b = pstack.top();
+            pstack.pop();
+            pstack.top() = p_mul(pstack.top(), b);
+            p += sizeof(ParserExeMUL);
+            break;
+        }
+        case PARSER_EXE_DIV_F:
+        {
+            PInterval b = pstack.top();
+            pstack.pop();
+            pstack.top() = p_div(pstack.top(), b);
+            p += sizeof(ParserExeDIV_F);
+            break;
+        }
+        case PARSER_EXE_DIV_B:
+        {
+            PInterval a = pstack.top();
+            pstack.pop();
+            pstack.top() = p_div(a, pstack.top());
+            p += sizeof(ParserExeDIV_B);
+            break;
+        }
+        case PARSER_EXE_NEG:
+        {
+            pstack.top() = p_neg(pstack.top());
+            p += sizeof(ParserExeNEG);
+            break;
+        }
+        case PARSER_EXE_F1:
+        {
+            pstack.top() = p_f1(((ParserExeF1 const*)p)->ftype, pstack.top());
+            p += sizeof(ParserExeF1);
+            break;
+        }
+        case PARSER_EXE_F2_F:
+        {
+            PInterval b = pstack.top();
+            pstack.pop();
+            pstack.top() = p_f2(((ParserExeF2_F const*)p)->ftype, pstack.top(), b);
+            p += sizeof(ParserExeF2_F);
+            break;
+        }
+        case PARSER_EXE_F2_B:
+        {
+            PInterval a = pstack.top();
+            pstack.pop();
+            pstack.top() = p_f2(((ParserExeF2_B const*)p)->ftype, a, pstack.top());
+            p += sizeof(ParserExeF2_B);
+            break;
+        }
+        case PARSER_EXE_ADD_VP:
+        {
+            int i = ((ParserExeADD_VP const*)p)->i;
+            double v = ((ParserExeADD_VP const*)p)->v;
+            pstack.push(p_add(PInterval{v,v}, AMREX_PARSER_GET_INTERVAL(i)));
+            p += sizeof(ParserExeADD_VP);
+            break;
+        }
+        case PARSER_EXE_SUB_VP:
+        {
+            int i = ((ParserExeSUB_VP const*)p)->i;
+            double v = ((ParserExeSUB_VP const*)p)->v;
+            pstack.push(p_sub(PInterval{v,v}, AMREX_PARSER_GET_INTERVAL(i)));
+            p += sizeof(ParserExeSUB_VP);
+            break;
+        }
+        case PARSER_EXE_MUL_VP:
+        {
+            int i = ((ParserExeMUL_VP const*)p)->i;
+            double v = ((ParserExeMUL_VP const*)p)->v;
+            pstack.push(p_mul(PInterval{v,v}, AMREX_PARSER_GET_INTERVAL(i)));
+            p += sizeof(ParserExeMUL_VP);
+            break;
+        }
+        case PARSER_EXE_DIV_VP:
+        {
+            int i = ((ParserExeDIV_VP const*)p)->i;
+            double v = ((ParserExeDIV_VP const*)p)->v;
+            pstack.push(p_div(PInterval{v,v}, AMREX_PARSER_GET_INTERVAL(i)));
+            p += sizeof(ParserExeDIV_VP);
+            break;
+        }
+        case PARSER_EXE_ADD_PP:
+        {
+            int i1 = ((ParserExeADD_PP const*)p)->i1;
+            int i2 = ((ParserExeADD_PP const*)p)->i2;
+            pstack.push(p_add(AMREX_PARSER_GET_INTERVAL(i1), AMREX_PARSER_GET_INTERVAL(i2)));
+            p += sizeof(ParserExeADD_PP);
+            break;
+        }
+        case PARSER_EXE_SUB_PP:
+        {
+            int i1 = ((ParserExeSUB_PP const*)p)->i1;
+            int i2 = ((ParserExeSUB_PP const*)p)->i2;
+            pstack.push(p_sub(AMREX_PARSER_GET_INTERVAL(i1), AMREX_PARSER_GET_INTERVAL(i2)));
+            p += sizeof(ParserExeSUB_PP);
+            break;
+        }
+        case PARSER_EXE_MUL_PP:
+        {
+            int i1 = ((ParserExeMUL_PP const*)p)->i1;
+            int i2 = ((ParserExeMUL_PP const*)p)->i2;
+            if (i1 == i2) {
+                pstack.push(p_sqr(AMREX_PARSER_GET_INTERVAL(i1)));
+            } else {
+                pstack.push(p_mul(AMREX_PARSER_GET_INTERVAL(i1), AMREX_PARSER_GET_INTERVAL(i2)));
+            }
+            p += sizeof(ParserExeMUL_PP);
+            break;
+        }
+        case PARSER_EXE_DIV_PP:
+        {
+            int i1 = ((ParserExeDIV_PP const*)p)->i1;
+            int i2 = ((ParserExeDIV_PP const*)p)->i2;
+            pstack.push(p_div(AMREX_PARSER_GET_INTERVAL(i1), AMREX_PARSER_GET_INTERVAL(i2)));
+            p += sizeof(ParserExeDIV_PP);
+            break;
+        }
+        case PARSER_EXE_NEG_P:
+        {
+            int i = ((ParserExeNEG_P const*)p)->i;
+            pstack.push(p_neg(AMREX_PARSER_GET_INTERVAL(i)));
+            p += sizeof(ParserExeNEG_P);
+            break;
+        }
+        case PARSER_EXE_ADD_VN:
+        {
+            double v = ((ParserExeADD_VN const*)p)->v;
+            pstack.top() = p_add(pstack.top(), PInterval{v,v});
+            p += sizeof(ParserExeADD_VN);
+            break;
+        }
+        case PARSER_EXE_SUB_VN:
+        {
+            double v = ((ParserExeSUB_VN const*)p)->v;
+            pstack.top() = p_sub(PInterval{v,v}, pstack.top());
+            p += sizeof(ParserExeSUB_VN);
+            break;
+        }
+        case PARSER_EXE_MUL_VN:
+        {
+            double v = ((ParserExeMUL_VN const*)p)->v;
+            pstack.top() = p_mul(pstack.top(), PInterval{v,v});
+            p += sizeof(ParserExeMUL_VN);
+            break;
+        }
+        case PARSER_EXE_DIV_VN:
+        {
+            double v = ((ParserExeDIV_VN const*)p)->v;
+            pstack.top() = p_div(PInterval{v,v}, pstack.top());
+            p += sizeof(ParserExeDIV_VN);
+            break;
+        }
+        case PARSER_EXE_ADD_PN:
+        {
+            int i = ((ParserExeADD_PN const*)p)->i;
+            pstack.top() = p_add(pstack.top(), AMREX_PARSER_GET_INTERVAL(i));
+            p += sizeof(ParserExeADD_PN);
+            break;
+        }
+        case PARSER_EXE_SUB_PN:
+        {
+            int i = ((ParserExeSUB_PN const*)p)->i;
+            pstack.top() = p_sub(AMREX_PARSER_GET_INTERVAL(i), pstack.top());
+            if (((ParserExeSUB_PN const*)p)->sign < 0.0) {
+                pstack.top() = p_neg(pstack.top());
+            }
+            p += sizeof(ParserExeSUB_PN);
+            break;
+        }
+        case PARSER_EXE_MUL_PN:
+        {
+            int i = ((ParserExeMUL_PN const*)p)->i;
+            pstack.top() = p_mul(pstack.top(), AMREX_PARSER_GET_INTERVAL(i));
+            p += sizeof(ParserExeMUL_PN);
+            break;
+        }
+        case PARSER_EXE_DIV_PN:
+        {
+            int i = ((ParserExeDIV_PN const*)p)->i;
+            if (((ParserExeDIV_PN const*)p)->reverse) {
+                pstack.top() = p_div(pstack.top(), AMREX_PARSER_GET_INTERVAL(i));
+            } else {
+                pstack.top() = p_div(AMREX_PARSER_GET_INTERVAL(i), pstack.top());
+            }
+            p += sizeof(ParserExeDIV_PN);
+            break;
+        }
+        case PARSER_EXE_IF:
+        {
+            // The true branch ends with a jump over the false branch.
+            PInterval cond = pstack.top();
+            pstack.pop();
+            int offset = ((ParserExeIF const*)p)->offset;
+            p += sizeof(ParserExeIF);
+            if (p_is_zero(cond)) {
+                p += offset;
+            } else if (p_has_zero(cond)) {
+                char const* pjump = p + offset - sizeof(ParserExeJUMP);
+                char const* pfalse = p + offset;
+                char const* pnext = pfalse + ((ParserExeJUMP const*)pjump)->offset;
+                PStack tstack = pstack;
+                p_eval(p, pjump, x, tstack);
+                p_eval(pfalse, pnext, x, pstack);
+                pstack.top() = p_hull(pstack.top(), tstack.top());
+                p = pnext;
+            }
+            break;
+        }
+        case PARSER_EXE_JUMP:
+        {
+            int offset = ((ParserExeJUMP const*)p)->offset;
+            p += sizeof(ParserExeJUMP) + offset;
+            break;
+        }
+        default:
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(false,"parser_exe_bounds: unknown node type");
+        }
+    }
+#undef AMREX_PARSER_GET_INTERVAL
+}
+
+}
+
+bool
+parser_exe_bounds (char const* p, double const* xlo, double const* xhi,
+                   int nvars, double& flo, double& fhi)
+{
+    Vector<PInterval> x(nvars);
+    for (int i = 0; i < nvars; ++i) {
+        x[i] = PInterval{xlo[i], xhi[i]};
+    }
+    PStack pstack;
+    p_eval(p, nullptr, x.data(), pstack);
+    flo = pstack.top().lo;
+    fhi = pstack.top().hi;
+    return std::isfinite(flo) && std::isfinite(fhi);
+}
+
 }
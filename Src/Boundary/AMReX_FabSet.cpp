@@ -93,6 +93,14 @@ FabSet::copyTo (MultiFab& dest, int ngrow, int scomp, int dcomp, int ncomp,
     dest.ParallelCopy(m_mf,scomp,dcomp,ncomp,0,ngrow,period);
 }
 
+void
+FabSet::copyTo_nowait (MultiFab& dest, int ngrow, int scomp, int dcomp, int ncomp,
+                       const Periodicity& period) const
+{
+    BL_ASSERT(boxArray() != dest.boxArray());
+    dest.ParallelCopy_nowait(m_mf,scomp,dcomp,ncomp,0,ngrow,period);
+}
+
 void
 FabSet::plusTo (MultiFab& dest, int ngrow, int scomp, int dcomp, int ncomp,
                 const Periodicity& period) const
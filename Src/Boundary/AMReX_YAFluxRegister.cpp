@@ -347,28 +347,134 @@ YAFluxRegister::FineAdd (const MFIter& mfi,
 void
 YAFluxRegister::Reflux (MultiFab& state, int dc)
 {
-    if (!m_cfp_mask.empty())
+    Reflux_nowait(state, dc);
+    Reflux_finish();
+}
+
+void
+YAFluxRegister::Reflux_nowait (MultiFab& state, int dc)
+{
+    Reflux_nowait({this}, {&state}, {dc});
+}
+
+void
+YAFluxRegister::Reflux_finish ()
+{
+    Reflux_finish({this});
+}
+
+void
+YAFluxRegister::Reflux_nowait (Vector<YAFluxRegister*> const& fr,
+                               Vector<MultiFab*> const& state,
+                               Vector<int> const& dc)
+{
+    BL_PROFILE("YAFluxRegister::Reflux_nowait()");
+    AMREX_ASSERT(fr.size() == state.size() && fr.size() == dc.size());
+    for (int i = 0; i < fr.size(); ++i) {
+        BL_ASSERT(state[i]->nComp() >= dc[i] + fr[i]->m_ncomp);
+        fr[i]->m_reflux_state = state[i];
+        fr[i]->m_reflux_dc = dc[i];
+    }
+    CrseDataAdd_nowait(fr);
+}
+
+void
+YAFluxRegister::Reflux_finish (Vector<YAFluxRegister*> const& fr)
+{
+    BL_PROFILE("YAFluxRegister::Reflux_finish()");
+    CrseDataAdd_finish(fr);
+    for (auto* r : fr) {
+        AMREX_ASSERT(r->m_reflux_state != nullptr);
+        MultiFab::Add(*r->m_reflux_state, r->m_crse_data, 0, r->m_reflux_dc, r->m_ncomp, 0);
+        r->m_reflux_state = nullptr;
+    }
+}
+
+void
+YAFluxRegister::CrseDataAdd_nowait (Vector<YAFluxRegister*> const& fr)
+{
+    for (auto* r : fr)
     {
-        const int ncomp = m_ncomp;
+        if (!r->m_cfp_mask.empty())
+        {
+            const int ncomp = r->m_ncomp;
+            MultiFab& cfpatch = r->m_cfpatch;
+            const MultiFab& cfp_mask = r->m_cfp_mask;
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (MFIter mfi(m_cfpatch); mfi.isValid(); ++mfi)
-        {
-            const Box& bx = m_cfpatch[mfi].box();
-            auto const maskfab = m_cfp_mask.array(mfi);
-            auto       cfptfab = m_cfpatch.array(mfi);
-            AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+            for (MFIter mfi(cfpatch); mfi.isValid(); ++mfi)
             {
-                cfptfab(i,j,k,n) *= maskfab(i,j,k);
-            });
+                const Box& bx = cfpatch[mfi].box();
+                auto const maskfab = cfp_mask.const_array(mfi);
+                auto       cfptfab = cfpatch.array(mfi);
+                AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+                {
+                    cfptfab(i,j,k,n) *= maskfab(i,j,k);
+                });
+            }
         }
     }
 
-    m_crse_data.ParallelCopy(m_cfpatch, m_crse_geom.periodicity(), FabArrayBase::ADD);
+    // The registers can share the exchange if their patches and coarse
+    // data have the same layouts.
+    bool same_layout = fr.size() > 1;
+    int ncomp = 0;
+    for (auto* r : fr) {
+        same_layout = same_layout
+            && r->m_cfpatch.boxArray() == fr[0]->m_cfpatch.boxArray()
+            && r->m_cfpatch.DistributionMap() == fr[0]->m_cfpatch.DistributionMap()
+            && r->m_crse_data.boxArray() == fr[0]->m_crse_data.boxArray()
+            && r->m_crse_data.DistributionMap() == fr[0]->m_crse_data.DistributionMap()
+            && r->m_crse_geom.periodicity() == fr[0]->m_crse_geom.periodicity();
+        ncomp += r->m_ncomp;
+    }
 
-    BL_ASSERT(state.nComp() >= dc + m_ncomp);
-    MultiFab::Add(state, m_crse_data, 0, dc, m_ncomp, 0);
+    if (same_layout)
+    {
+        YAFluxRegister& r0 = *fr[0];
+        r0.m_group_cfpatch = std::make_unique<MultiFab>(r0.m_cfpatch.boxArray(),
+                                                        r0.m_cfpatch.DistributionMap(),
+                                                        ncomp, 0);
+        r0.m_group_crse_data = std::make_unique<MultiFab>(r0.m_crse_data.boxArray(),
+                                                          r0.m_crse_data.DistributionMap(),
+                                                          ncomp, 0);
+        for (int i = 0, n = 0; i < fr.size(); n += fr[i]->m_ncomp, ++i) {
+            MultiFab::Copy(*r0.m_group_cfpatch, fr[i]->m_cfpatch, 0, n, fr[i]->m_ncomp, 0);
+            MultiFab::Copy(*r0.m_group_crse_data, fr[i]->m_crse_data, 0, n, fr[i]->m_ncomp, 0);
+        }
+        r0.m_group_crse_data->ParallelCopy_nowait(*r0.m_group_cfpatch, 0, 0, ncomp, 0, 0,
+                                                  r0.m_crse_geom.periodicity(),
+                                                  FabArrayBase::ADD);
+    }
+    else
+    {
+        for (auto* r : fr) {
+            r->m_crse_data.ParallelCopy_nowait(r->m_cfpatch, r->m_crse_geom.periodicity(),
+                                               FabArrayBase::ADD);
+        }
+    }
+}
+
+void
+YAFluxRegister::CrseDataAdd_finish (Vector<YAFluxRegister*> const& fr)
+{
+    if (fr.size() > 0 && fr[0]->m_group_crse_data)
+    {
+        YAFluxRegister& r0 = *fr[0];
+        r0.m_group_crse_data->ParallelCopy_finish();
+        for (int i = 0, n = 0; i < fr.size(); n += fr[i]->m_ncomp, ++i) {
+            MultiFab::Copy(fr[i]->m_crse_data, *r0.m_group_crse_data, n, 0, fr[i]->m_ncomp, 0);
+        }
+        r0.m_group_cfpatch.reset();
+        r0.m_group_crse_data.reset();
+    }
+    else
+    {
+        for (auto* r : fr) {
+            r->m_crse_data.ParallelCopy_finish();
+        }
+    }
 }
 
 }
@@ -12,7 +12,14 @@
 #include <AMReX_EB2.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX.H>
+#include <AMReX_FileSystem.H>
+#include <AMReX_Utility.H>
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -21,11 +28,16 @@ AMREX_EXPORT Vector<std::unique_ptr<IndexSpace> > IndexSpace::m_instance;
 AMREX_EXPORT int max_grid_size = 64;
 AMREX_EXPORT bool extend_domain_face = true;
 
+namespace {
+    std::string cache_dir;
+}
+
 void Initialize ()
 {
     ParmParse pp("eb2");
     pp.query("max_grid_size", max_grid_size);
     pp.query("extend_domain_face", extend_domain_face);
+    pp.query("cache_dir", cache_dir);
 
     amrex::ExecOnFinalize(Finalize);
 }
@@ -33,6 +45,7 @@ void Initialize ()
 void Finalize ()
 {
     IndexSpace::clear();
+    cache_dir.clear();
 }
 
 bool ExtendDomainFace ()
@@ -71,6 +84,181 @@ const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     return nullptr;
 }
 
+IndexSpaceChkptFile::IndexSpaceChkptFile (const std::string& dirname, const Geometry& geom,
+                                          int required_coarsening_level,
+                                          int max_coarsening_level, int ngrow)
+{
+    AMREX_ALWAYS_ASSERT(required_coarsening_level >= 0 && required_coarsening_level <= 30);
+    max_coarsening_level = std::max(required_coarsening_level,max_coarsening_level);
+    max_coarsening_level = std::min(30,max_coarsening_level);
+
+    int ngrow_finest = std::max(ngrow,0);
+    for (int i = 1; i <= required_coarsening_level; ++i) {
+        ngrow_finest *= 2;
+    }
+
+    m_geom.push_back(geom);
+    m_domain.push_back(geom.Domain());
+    m_ngrow.push_back(ngrow_finest);
+    m_chkptlevel.reserve(max_coarsening_level+1);
+    m_chkptlevel.emplace_back(this, dirname, geom);
+
+    for (int ilev = 1; ilev <= max_coarsening_level; ++ilev)
+    {
+        bool coarsenable = m_geom.back().Domain().coarsenable(2,2);
+        if (!coarsenable) {
+            if (ilev <= required_coarsening_level) {
+                amrex::Abort("IndexSpaceChkptFile: domain is not coarsenable at level "+std::to_string(ilev));
+            } else {
+                break;
+            }
+        }
+
+        int ng = (ilev > required_coarsening_level) ? 0 : m_ngrow.back()/2;
+
+        Box cdomain = amrex::coarsen(m_geom.back().Domain(),2);
+        Geometry cgeom = amrex::coarsen(m_geom.back(),2);
+        m_chkptlevel.emplace_back(this, ilev, EB2::max_grid_size, ng, cgeom, m_chkptlevel[ilev-1]);
+        if (!m_chkptlevel.back().isOK()) {
+            m_chkptlevel.pop_back();
+            if (ilev <= required_coarsening_level) {
+                m_ok = false;
+            }
+            break;
+        }
+        m_geom.push_back(cgeom);
+        m_domain.push_back(cdomain);
+        m_ngrow.push_back(ng);
+    }
+}
+
+const Level&
+IndexSpaceChkptFile::getLevel (const Geometry& geom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), geom.Domain());
+    int i = std::distance(m_domain.begin(), it);
+    return m_chkptlevel[i];
+}
+
+const Geometry&
+IndexSpaceChkptFile::getGeometry (const Box& dom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), dom);
+    int i = std::distance(m_domain.begin(), it);
+    return m_geom[i];
+}
+
+const std::string&
+GeometryCacheDir ()
+{
+    return cache_dir;
+}
+
+std::string
+GeometryCacheName (const Geometry& geom, int ngrow_finest, bool a_extend_domain_face,
+                   const std::string& gshop_type)
+{
+    if (cache_dir.empty()) return std::string();
+
+    std::ostringstream key;
+    key << std::setprecision(17)
+        << AMREX_SPACEDIM << " " << sizeof(Real) << "\n"
+        << geom.Domain() << " " << geom.Coord() << "\n";
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        key << geom.ProbLo(idim) << " " << geom.ProbHi(idim) << " "
+            << geom.isPeriodic(idim) << "\n";
+    }
+    key << ngrow_finest << " " << a_extend_domain_face << " " << max_grid_size << "\n"
+        << gshop_type << "\n";
+
+    // All eb2.* parameters, including those read while building the
+    // levels (e.g., eb2.small_volfrac) and eb2.cache_key, but not those
+    // that do not change the geometry.
+    const std::string prefix("eb2.");
+    ParmParse pp;
+    for (auto const& entry : pp.table()) {
+        if (entry.m_name.compare(0, prefix.size(), prefix) == 0 &&
+            entry.m_name != "eb2.cache_dir" &&
+            entry.m_name != "eb2.sparse_cut_data")
+        {
+            key << entry.m_name << " =";
+            for (auto const& v : entry.m_vals) {
+                key << " " << v;
+            }
+            key << "\n";
+        }
+    }
+
+    // 64-bit FNV-1a
+    std::uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : key.str()) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+
+    std::ostringstream name;
+    name << cache_dir << "/eb2_" << std::hex << std::setw(16) << std::setfill('0') << h;
+    return name.str();
+}
+
+IndexSpace*
+ReadGeometryCache (const std::string& name, const Geometry& geom,
+                   int required_coarsening_level, int max_coarsening_level, int ngrow)
+{
+    BL_PROFILE("EB2::ReadGeometryCache()");
+
+    int exist = 0;
+    if (ParallelDescriptor::IOProcessor()) {
+        exist = FileSystem::Exists(name+"/Header");
+    }
+    ParallelDescriptor::Bcast(&exist, 1, ParallelDescriptor::IOProcessorNumber());
+    if (!exist) return nullptr;
+
+    auto is = new IndexSpaceChkptFile(name, geom, required_coarsening_level,
+                                      max_coarsening_level, ngrow);
+    if (!is->isOK()) {
+        if (amrex::Verbose() > 0) {
+            amrex::Print() << "EB2: required coarse levels cannot be built from " << name << "\n";
+        }
+        delete is;
+        return nullptr;
+    }
+
+    if (amrex::Verbose() > 0) {
+        amrex::Print() << "EB2: read geometry from " << name << "\n";
+    }
+    return is;
+}
+
+void
+WriteGeometryCache (const std::string& name, const Level& level)
+{
+    BL_PROFILE("EB2::WriteGeometryCache()");
+
+    // The entry is written to a temporary directory and then renamed, so
+    // that other runs sharing the cache never see a partial entry.
+    std::array<char,64> suffix{};
+    if (ParallelDescriptor::IOProcessor()) {
+        std::string u = amrex::UniqueString();
+        std::copy_n(u.begin(), std::min(u.size(), suffix.size()-1), suffix.begin());
+    }
+    ParallelDescriptor::Bcast(suffix.data(), suffix.size(), ParallelDescriptor::IOProcessorNumber());
+    const std::string tmpname = name + ".tmp_" + suffix.data();
+
+    level.write(tmpname);
+    ParallelDescriptor::Barrier();
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (std::rename(tmpname.c_str(), name.c_str()) != 0) {
+            // Another run has written the same entry in the meantime.
+            FileSystem::RemoveAll(tmpname);
+        } else if (amrex::Verbose() > 0) {
+            amrex::Print() << "EB2: wrote geometry to " << name << "\n";
+        }
+    }
+    ParallelDescriptor::Barrier();
+}
+
 void
 Build (const Geometry& geom, int required_coarsening_level,
        int max_coarsening_level, int ngrow, bool build_coarse_level_by_coarsening)
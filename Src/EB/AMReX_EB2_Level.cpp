@@ -1,7 +1,10 @@
 
 #include <AMReX_EB2_Level.H>
 #include <AMReX_IArrayBox.H>
+#include <AMReX_Utility.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -916,4 +919,207 @@ Level::fillLevelSet (MultiFab& levelset, const Geometry& geom) const
     }
 }
 
+namespace {
+    const std::string chkpt_version("EB2_Level_V1");
+
+    std::string field_name (const std::string& dirname, const std::string& name, int idim)
+    {
+        return dirname + "/" + name + std::to_string(idim);
+    }
+}
+
+void
+Level::write (const std::string& dirname) const
+{
+    BL_PROFILE("EB2::Level::write()");
+
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!amrex::UtilCreateDirectory(dirname, 0755)) {
+            amrex::CreateDirectoryFailed(dirname);
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::string hdrname = dirname + "/Header";
+        std::ofstream os(hdrname.c_str());
+        if (!os.good()) {
+            amrex::FileOpenFailed(hdrname);
+        }
+        os << chkpt_version << "\n"
+           << m_allregular << "\n"
+           << m_ngrow << "\n"
+           << m_levelset.nGrow() << " " << m_volfrac.nGrow() << "\n";
+        for (auto const* ba : {&m_grids, &m_covered_grids}) {
+            os << ba->size() << "\n";
+            if (!ba->empty()) {
+                ba->writeOn(os);
+                os << "\n";
+            }
+        }
+        if (!os.good()) {
+            amrex::Abort("EB2::Level::write: failed to write " + hdrname);
+        }
+    }
+
+    if (m_allregular) return;
+
+    // The neighbor bits of EBCellFlag do not fit in the mantissa of a
+    // single precision Real.  So the flags are stored in 16-bit halves.
+    MultiFab cellflag(m_grids, m_dmap, 2, m_cellflag.nGrow());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cellflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& flag = m_cellflag.const_array(mfi);
+        auto const& a = cellflag.array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+        {
+            uint32_t v = flag(i,j,k).getValue();
+            a(i,j,k,0) = static_cast<Real>(v & 0xffffu);
+            a(i,j,k,1) = static_cast<Real>(v >> 16);
+        });
+    }
+
+    VisMF::Write(cellflag, dirname+"/cellflag");
+    VisMF::Write(m_levelset, dirname+"/levelset");
+    VisMF::Write(m_volfrac, dirname+"/volfrac");
+    VisMF::Write(m_centroid, dirname+"/centroid");
+    VisMF::Write(m_bndryarea, dirname+"/bndryarea");
+    VisMF::Write(m_bndrycent, dirname+"/bndrycent");
+    VisMF::Write(m_bndrynorm, dirname+"/bndrynorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Write(m_areafrac[idim], field_name(dirname, "areafrac", idim));
+        VisMF::Write(m_facecent[idim], field_name(dirname, "facecent", idim));
+        VisMF::Write(m_edgecent[idim], field_name(dirname, "edgecent", idim));
+    }
+}
+
+ChkptFileLevel::ChkptFileLevel (IndexSpace const* is, const std::string& dirname,
+                                const Geometry& geom)
+    : Level(is, geom)
+{
+    BL_PROFILE("EB2::ChkptFileLevel()-fine");
+
+    std::string hdrname = dirname + "/Header";
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(hdrname, fileCharPtr);
+    std::istringstream hdr(fileCharPtr.dataPtr(), std::istringstream::in);
+
+    std::string version;
+    int ng_levelset, ng;
+    hdr >> version;
+    if (version != chkpt_version) {
+        amrex::Abort("EB2::ChkptFileLevel: unknown version " + version + " in " + hdrname);
+    }
+    hdr >> m_allregular >> m_ngrow >> ng_levelset >> ng;
+    for (auto* ba : {&m_grids, &m_covered_grids}) {
+        Long nboxes;
+        hdr >> nboxes;
+        if (nboxes > 0) {
+            ba->readFrom(hdr);
+        }
+    }
+    if (hdr.fail()) {
+        amrex::Abort("EB2::ChkptFileLevel: failed to read " + hdrname);
+    }
+
+    if (m_allregular) {
+        m_ok = true;
+        return;
+    }
+
+    m_dmap.define(m_grids);
+
+    MFInfo mf_info;
+    mf_info.SetTag("EB2::Level");
+    MultiFab cellflag(m_grids, m_dmap, 2, ng);
+    m_cellflag.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_levelset.define(amrex::convert(m_grids,IntVect::TheNodeVector()), m_dmap, 1, ng_levelset, mf_info);
+    m_volfrac.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_centroid.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndryarea.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_bndrycent.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndrynorm.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_areafrac[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, 1, ng, mf_info);
+        m_facecent[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, AMREX_SPACEDIM-1, ng, mf_info);
+        IntVect edge_type{1}; edge_type[idim] = 0;
+        m_edgecent[idim].define(amrex::convert(m_grids, edge_type), m_dmap, 1, ng, mf_info);
+    }
+
+    VisMF::Read(cellflag, dirname+"/cellflag");
+    VisMF::Read(m_levelset, dirname+"/levelset");
+    VisMF::Read(m_volfrac, dirname+"/volfrac");
+    VisMF::Read(m_centroid, dirname+"/centroid");
+    VisMF::Read(m_bndryarea, dirname+"/bndryarea");
+    VisMF::Read(m_bndrycent, dirname+"/bndrycent");
+    VisMF::Read(m_bndrynorm, dirname+"/bndrynorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Read(m_areafrac[idim], field_name(dirname, "areafrac", idim));
+        VisMF::Read(m_facecent[idim], field_name(dirname, "facecent", idim));
+        VisMF::Read(m_edgecent[idim], field_name(dirname, "edgecent", idim));
+    }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cellflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& flag = m_cellflag.array(mfi);
+        auto const& a = cellflag.const_array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+        {
+            flag(i,j,k) = EBCellFlag(static_cast<uint32_t>(a(i,j,k,0))
+                                     | (static_cast<uint32_t>(a(i,j,k,1)) << 16));
+        });
+    }
+
+    m_ok = true;
+}
+
+ChkptFileLevel::ChkptFileLevel (IndexSpace const* is, int /*ilev*/, int max_grid_size,
+                                int /*ngrow*/, const Geometry& geom, ChkptFileLevel& fineLevel)
+    : Level(is, geom)
+{
+    if (fineLevel.isAllRegular()) {
+        m_allregular = true;
+        m_ok = true;
+        return;
+    }
+
+    BL_PROFILE("EB2::ChkptFileLevel()-coarse");
+
+    const BoxArray& fine_grids = fineLevel.m_grids;
+    const BoxArray& fine_covered_grids = fineLevel.m_covered_grids;
+
+    const int coarse_ratio = 2;
+    const int min_width = 8;
+    bool coarsenable = fine_grids.coarsenable(coarse_ratio, min_width)
+        && (fine_covered_grids.empty() || fine_covered_grids.coarsenable(coarse_ratio));
+
+    m_ngrow = amrex::coarsen(fineLevel.m_ngrow,2);
+    if (amrex::scale(m_ngrow,2) != fineLevel.m_ngrow) {
+        m_ngrow = IntVect::TheZeroVector();
+    }
+
+    if (coarsenable)
+    {
+        int ierr = coarsenFromFine(fineLevel, true);
+        m_ok = (ierr == 0);
+    }
+    else
+    {
+        Level fine_level_2(is, fineLevel.m_geom);
+        fine_level_2.prepareForCoarsening(fineLevel, max_grid_size, amrex::scale(m_ngrow,2));
+        int ierr = coarsenFromFine(fine_level_2, false);
+        m_ok = (ierr == 0);
+    }
+}
+
 }}
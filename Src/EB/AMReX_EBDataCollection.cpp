@@ -2,6 +2,7 @@
 #include <AMReX_EBDataCollection.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_ParmParse.H>
 
 #include <AMReX_EB2_Level.H>
 
@@ -64,6 +65,29 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
         a_level.fillFaceCent(m_facecent, m_geom);
         a_level.fillEdgeCent(m_edgecent, m_geom);
     }
+
+    // Most of the points in a cut box are regular or covered, so the
+    // cut-cell data may be kept in sparse storage.
+    bool sparse_cut_data = false;
+    {
+        ParmParse pp("eb2");
+        pp.query("sparse_cut_data", sparse_cut_data);
+    }
+    if (sparse_cut_data && m_support >= EBSupport::volume)
+    {
+        m_centroid->compress();
+        if (m_support == EBSupport::full)
+        {
+            m_bndrycent->compress();
+            m_bndryarea->compress();
+            m_bndrynorm->compress();
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_areafrac[idim]->compress();
+                m_facecent[idim]->compress();
+                m_edgecent[idim]->compress();
+            }
+        }
+    }
 }
 
 EBDataCollection::~EBDataCollection ()
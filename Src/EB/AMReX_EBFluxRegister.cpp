@@ -229,26 +229,66 @@ EBFluxRegister::FineAdd (const MFIter& mfi,
 
 void
 EBFluxRegister::Reflux (MultiFab& crse_state, const amrex::MultiFab& crse_vfrac,
-                        MultiFab& fine_state, const amrex::MultiFab& /*fine_vfrac*/)
+                        MultiFab& fine_state, const amrex::MultiFab& fine_vfrac)
 {
-    if (!m_cfp_mask.empty())
-    {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-        for (MFIter mfi(m_cfpatch); mfi.isValid(); ++mfi)
-        {
-            Array4<Real> const& cfa = m_cfpatch.array(mfi);
-            Array4<Real const> const& m = m_cfp_mask.const_array(mfi);
-            const Box& bx = mfi.fabbox();
-            AMREX_HOST_DEVICE_PARALLEL_FOR_4D(bx,m_ncomp,i,j,k,n,
-            {
-                cfa(i,j,k,n) *= m(i,j,k);
-            });
-        }
+    Reflux_nowait(crse_state, crse_vfrac, fine_state, fine_vfrac);
+    Reflux_finish();
+}
+
+void
+EBFluxRegister::Reflux_nowait (MultiFab& crse_state, const amrex::MultiFab& crse_vfrac,
+                               MultiFab& fine_state, const amrex::MultiFab& fine_vfrac)
+{
+    Reflux_nowait({this}, {&crse_state}, {&crse_vfrac}, {&fine_state}, {&fine_vfrac});
+}
+
+void
+EBFluxRegister::Reflux_finish ()
+{
+    Reflux_finish({this});
+}
+
+void
+EBFluxRegister::Reflux_nowait (Vector<EBFluxRegister*> const& fr,
+                               Vector<MultiFab*> const& crse_state,
+                               Vector<MultiFab const*> const& crse_vfrac,
+                               Vector<MultiFab*> const& fine_state,
+                               Vector<MultiFab const*> const& /*fine_vfrac*/)
+{
+    BL_PROFILE("EBFluxRegister::Reflux_nowait()");
+    AMREX_ASSERT(fr.size() == crse_state.size() && fr.size() == crse_vfrac.size()
+                 && fr.size() == fine_state.size());
+    Vector<YAFluxRegister*> yafr(fr.begin(), fr.end());
+    for (int i = 0; i < fr.size(); ++i) {
+        fr[i]->m_reflux_state = crse_state[i];
+        fr[i]->m_reflux_dc = 0;
+        fr[i]->m_reflux_crse_vfrac = crse_vfrac[i];
+        fr[i]->m_reflux_fine_state = fine_state[i];
+    }
+    CrseDataAdd_nowait(yafr);
+}
+
+void
+EBFluxRegister::Reflux_finish (Vector<EBFluxRegister*> const& fr)
+{
+    BL_PROFILE("EBFluxRegister::Reflux_finish()");
+    Vector<YAFluxRegister*> yafr(fr.begin(), fr.end());
+    CrseDataAdd_finish(yafr);
+    for (auto* r : fr) {
+        AMREX_ASSERT(r->m_reflux_state != nullptr);
+        r->RefluxAfterAdd();
+        r->m_reflux_state = nullptr;
+        r->m_reflux_crse_vfrac = nullptr;
+        r->m_reflux_fine_state = nullptr;
     }
+}
 
-    m_crse_data.ParallelCopy(m_cfpatch, m_crse_geom.periodicity(), FabArrayBase::ADD);
+void
+EBFluxRegister::RefluxAfterAdd ()
+{
+    MultiFab& crse_state = *m_reflux_state;
+    MultiFab const& crse_vfrac = *m_reflux_crse_vfrac;
+    MultiFab& fine_state = *m_reflux_fine_state;
 
     {
         MultiFab grown_crse_data(m_crse_data.boxArray(), m_crse_data.DistributionMap(),
@@ -658,7 +658,7 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
                     });
                 } else {
                     Array4<Real const> const& fa = fine.const_array(mfi);
-                    Array4<Real const> const& ba = barea.const_array(mfi);
+                    CutArray4 const& ba = barea.const_view(mfi);
                     AMREX_HOST_DEVICE_FOR_3D(tbx,i,j,k,
                     {
                         eb_avgdown_boundaries(i,j,k,fa,0,ca,0,ba,dratio,ncomp);
@@ -849,7 +849,7 @@ EB_interp_CC_to_Centroid (MultiFab& cent, const MultiFab& cc, int scomp, int dco
         else
         {
             const auto& flagfab = flags.const_array(mfi);
-            const auto& locfab = loc.const_array(mfi);
+            const auto& locfab = loc.const_view(mfi);
             const auto& ccfab = cc.array(mfi,scomp);
 
             AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( vbx, thread_box,
@@ -1,6 +1,7 @@
 
 #include <AMReX_MultiCutFab.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_GpuContainers.H>
 
 #ifdef AMREX_USE_OMP
 #include <omp.h>
@@ -8,17 +9,149 @@
 
 namespace amrex {
 
+namespace {
+    // 2-bit codes of the points that are not stored in sparse storage
+    int cut_value_code (Real const* v, int ncomp, Long nstride) noexcept
+    {
+        const Real v0 = v[0];
+        int code = (v0 == 0.0) ? 1 : ((v0 == 1.0) ? 2 : ((v0 == -1.0) ? 3 : 0));
+        for (int n = 1; n < ncomp && code != 0; ++n) {
+            if (v[n*nstride] != v0) { code = 0; }
+        }
+        return code;
+    }
+}
+
+void
+CutFab::compress ()
+{
+    if (m_sparse || dptr == nullptr || !ptr_owner) { return; }
+
+    const Long npts = box().numPts();
+    const int ncomp = nComp();
+    const Long nwords = (npts+31)/32;
+
+    Real const* hp = dptr;
+#ifdef AMREX_USE_GPU
+    Vector<Real> hbuf;
+    if (!arena()->isHostAccessible()) {
+        hbuf.resize(npts*ncomp);
+        Gpu::dtoh_memcpy(hbuf.data(), dptr, sizeof(Real)*hbuf.size());
+        hp = hbuf.data();
+    }
+#endif
+
+    Vector<std::uint64_t> codes(nwords, 0);
+    Vector<int> offsets(nwords, 0);
+    Long nstored = 0;
+    for (Long pt = 0; pt < npts; ++pt) {
+        if ((pt & 31) == 0) { offsets[pt >> 5] = static_cast<int>(nstored); }
+        const int code = cut_value_code(hp+pt, ncomp, npts);
+        if (code == 0) {
+            ++nstored;
+        } else {
+            codes[pt >> 5] |= static_cast<std::uint64_t>(code) << (2*(pt & 31));
+        }
+    }
+
+    const Long dense_bytes = nBytes();
+    const Long sparse_bytes = static_cast<Long>(sizeof(Real))*nstored*ncomp
+        + static_cast<Long>(sizeof(std::uint64_t)+sizeof(int))*nwords;
+    if (sparse_bytes >= dense_bytes) { return; }
+
+    Vector<Real> data(nstored*ncomp);
+    for (Long pt = 0, idx = 0; pt < npts; ++pt) {
+        if (((codes[pt >> 5] >> (2*(pt & 31))) & 3) == 0) {
+            for (int n = 0; n < ncomp; ++n) {
+                data[idx*ncomp+n] = hp[pt+n*npts];
+            }
+            ++idx;
+        }
+    }
+
+    m_sparse_data.resize(data.size());
+    m_sparse_codes.resize(codes.size());
+    m_sparse_offsets.resize(offsets.size());
+    Gpu::copyAsync(Gpu::hostToDevice, data.begin(), data.end(), m_sparse_data.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, codes.begin(), codes.end(), m_sparse_codes.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, offsets.begin(), offsets.end(), m_sparse_offsets.begin());
+    Gpu::streamSynchronize();
+
+    // Keep the box and the number of components, only the data go.
+    clear();
+    m_sparse = true;
+}
+
+void
+CutFab::decompress ()
+{
+    if (!m_sparse) { return; }
+
+    resize(box(), nComp());
+
+    CutArray4 const& src = const_view();
+    m_sparse = false;
+    Array4<Real> const& dst = array();
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D(box(), nComp(), i, j, k, n,
+    {
+        dst(i,j,k,n) = src(i,j,k,n);
+    });
+    Gpu::streamSynchronize();
+
+    m_sparse_data.clear();
+    m_sparse_data.shrink_to_fit();
+    m_sparse_codes.clear();
+    m_sparse_codes.shrink_to_fit();
+    m_sparse_offsets.clear();
+    m_sparse_offsets.shrink_to_fit();
+}
+
+Long
+CutFab::nBytesData () const noexcept
+{
+    if (m_sparse) {
+        return static_cast<Long>(sizeof(Real)*m_sparse_data.size()
+                                 + sizeof(std::uint64_t)*m_sparse_codes.size()
+                                 + sizeof(int)*m_sparse_offsets.size());
+    } else {
+        return nBytesOwned();
+    }
+}
+
+CutArray4
+CutFab::const_view () const noexcept
+{
+    // In sparse storage, const_array has a null pointer but the index space.
+    CutArray4 r;
+    r.arr = const_array();
+    if (m_sparse) {
+        r.sdata = m_sparse_data.data();
+        r.codes = m_sparse_codes.data();
+        r.offsets = m_sparse_offsets.data();
+    }
+    return r;
+}
+
 MultiCutFab::MultiCutFab ()
+    : m_mutex(std::make_unique<std::mutex>())
 {}
 
 MultiCutFab::MultiCutFab (const BoxArray& ba, const DistributionMapping& dm,
                           int ncomp, int ngrow, const FabArray<EBCellFlagFab>& cellflags)
     : m_data(ba,dm,ncomp,ngrow,MFInfo(),DefaultFabFactory<CutFab>()),
-      m_cellflags(&cellflags)
+      m_cellflags(&cellflags),
+      m_mutex(std::make_unique<std::mutex>())
 {
     remove();
 }
 
+MultiCutFab::MultiCutFab (MultiCutFab&& rhs) noexcept
+    : m_data(std::move(rhs.m_data)),
+      m_cellflags(rhs.m_cellflags),
+      m_has_sparse(std::exchange(rhs.m_has_sparse, false)),
+      m_mutex(std::make_unique<std::mutex>())
+{}
+
 MultiCutFab::~MultiCutFab ()
 {}
 
@@ -26,6 +159,7 @@ void
 MultiCutFab::define (const BoxArray& ba, const DistributionMapping& dm,
                      int ncomp, int ngrow, const FabArray<EBCellFlagFab>& cellflags)
 {
+    decompress();
     m_data.define(ba,dm,ncomp,ngrow,MFInfo(),DefaultFabFactory<CutFab>()),
     m_cellflags = &cellflags;
     remove();
@@ -47,6 +181,7 @@ const CutFab&
 MultiCutFab::operator[] (const MFIter& mfi) const noexcept
 {
     AMREX_ASSERT(ok(mfi));
+    densify(mfi);
     return m_data[mfi];
 }
 
@@ -54,6 +189,7 @@ CutFab&
 MultiCutFab::operator[] (const MFIter& mfi) noexcept
 {
     AMREX_ASSERT(ok(mfi));
+    densify(mfi);
     return m_data[mfi];
 }
 
@@ -61,6 +197,7 @@ Array4<Real const>
 MultiCutFab::const_array (const MFIter& mfi) const noexcept
 {
     AMREX_ASSERT(ok(mfi));
+    densify(mfi);
     return m_data.array(mfi);
 }
 
@@ -68,6 +205,7 @@ Array4<Real const>
 MultiCutFab::array (const MFIter& mfi) const noexcept
 {
     AMREX_ASSERT(ok(mfi));
+    densify(mfi);
     return m_data.array(mfi);
 }
 
@@ -75,9 +213,92 @@ Array4<Real>
 MultiCutFab::array (const MFIter& mfi) noexcept
 {
     AMREX_ASSERT(ok(mfi));
+    densify(mfi);
     return m_data.array(mfi);
 }
 
+CutArray4
+MultiCutFab::const_view (const MFIter& mfi) const noexcept
+{
+    AMREX_ASSERT(ok(mfi));
+    if (m_has_sparse) {
+        std::lock_guard<std::mutex> lock(*m_mutex);
+        return m_data[mfi].const_view();
+    } else {
+        return m_data[mfi].const_view();
+    }
+}
+
+void
+MultiCutFab::densify (const MFIter& mfi) const
+{
+    if (m_has_sparse) {
+        std::lock_guard<std::mutex> lock(*m_mutex);
+        auto& fab = const_cast<CutFab&>(m_data[mfi]);
+        if (fab.isSparse()) {
+            fab.decompress();
+            updateTagMemUsage(fab.nBytesOwned());
+        }
+    }
+}
+
+void
+MultiCutFab::compress ()
+{
+    BL_PROFILE("MultiCutFab::compress()");
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            CutFab& fab = m_data[mfi];
+            const Long dense_bytes = fab.nBytesOwned();
+            fab.compress();
+            if (fab.isSparse()) {
+                updateTagMemUsage(-dense_bytes);
+                m_has_sparse = true;
+            }
+        }
+    }
+}
+
+void
+MultiCutFab::decompress ()
+{
+    if (!m_has_sparse) { return; }
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi) && m_data[mfi].isSparse()) {
+            m_data[mfi].decompress();
+            updateTagMemUsage(m_data[mfi].nBytesOwned());
+        }
+    }
+    m_has_sparse = false;
+}
+
+Long
+MultiCutFab::nBytes () const noexcept
+{
+    Long r = 0;
+    for (MFIter mfi(m_data); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            r += m_data[mfi].nBytesData();
+        }
+    }
+    return r;
+}
+
+// The memory usage tags of m_data count the dense data only, like
+// FabArray::release does for the boxes freed by compress.
+void
+MultiCutFab::updateTagMemUsage (Long nbytes) const
+{
+    if (nbytes != 0) {
+        for (auto const& t : m_data.tags()) {
+            FabArrayBase::updateMemUsage(t, nbytes, nullptr);
+        }
+    }
+}
+
 bool
 MultiCutFab::ok (const MFIter& mfi) const noexcept
 {
@@ -87,6 +308,7 @@ MultiCutFab::ok (const MFIter& mfi) const noexcept
 void
 MultiCutFab::setVal (Real val)
 {
+    decompress();
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -106,6 +328,8 @@ MultiCutFab::setVal (Real val)
 void
 MultiCutFab::ParallelCopy (const MultiCutFab& src, int scomp, int dcomp, int ncomp, int sng, int dng, const Periodicity& period)
 {
+    decompress();
+    const_cast<MultiCutFab&>(src).decompress();
     m_data.ParallelCopy(src.m_data, scomp, dcomp, ncomp, sng, dng, period);
 }
 
@@ -123,7 +347,7 @@ MultiCutFab::ToMultiFab (Real regular_value, Real covered_value) const
         Box const& b = mfi.fabbox();
         Array4<Real> const& d = mf.array(mfi);
         if (t == FabType::singlevalued) {
-            Array4<Real const> const& s = m_data.const_array(mfi);
+            CutArray4 const& s = const_view(mfi);
             AMREX_HOST_DEVICE_PARALLEL_FOR_4D(b, ncomp, i, j, k, n,
             {
                 d(i,j,k,n) = s(i,j,k,n);
@@ -0,0 +1,389 @@
+#include <AMReX_FFT.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_BLProfiler.H>
+#include <cmath>
+
+#ifdef AMREX_USE_OMP
+#include <omp.h>
+#endif
+
+namespace amrex {
+namespace FFT {
+
+namespace {
+    constexpr int max_radix = 31;
+
+    Complex conj (Complex const& c) noexcept { return Complex(c.real(), -c.imag()); }
+
+    Complex expi (double theta) noexcept {
+        return Complex(static_cast<Real>(std::cos(theta)), static_cast<Real>(std::sin(theta)));
+    }
+}
+
+Plan1D::Plan1D (int n)
+    : m_n(n)
+{
+    AMREX_ALWAYS_ASSERT(n > 0);
+
+    // Radix 4 first, because its butterfly is the cheapest per point.
+    int largest = 1;
+    int m = n;
+    while (m % 4 == 0) {
+        m_factors.push_back(4);
+        m /= 4;
+    }
+    for (int p = 2; m > 1; ) {
+        if (m % p == 0) {
+            m_factors.push_back(p);
+            largest = p;
+            m /= p;
+        } else {
+            p = (p*p > m) ? m : p+1;
+        }
+    }
+
+    const double pi = 3.14159265358979323846;
+
+    if (largest <= max_radix)
+    {
+        m_twiddle.resize(n);
+        for (int t = 0; t < n; ++t) {
+            m_twiddle[t] = expi(-2.*pi*t/n);
+        }
+    }
+    else
+    {
+        // Bluestein: the transform is a convolution with a chirp, done
+        // with FFTs of a power-of-two length.
+        m_factors.clear();
+        m = 1;
+        while (m < 2*n-1) { m *= 2; }
+        m_conv = std::make_unique<Plan1D>(m);
+
+        m_chirp.resize(n);
+        for (Long t = 0; t < n; ++t) {
+            m_chirp[t] = expi(-pi*static_cast<double>((t*t) % (2*n))/n);
+        }
+
+        m_chirp_hat.resize(m, Complex(0.,0.));
+        m_chirp_hat[0] = conj(m_chirp[0]);
+        for (int t = 1; t < n; ++t) {
+            m_chirp_hat[t] = m_chirp_hat[m-t] = conj(m_chirp[t]);
+        }
+        Vector<Complex> work(m_conv->workSize());
+        m_conv->forward(m_chirp_hat.data(), work.data());
+    }
+}
+
+int
+Plan1D::workSize () const noexcept
+{
+    if (m_conv) {
+        return m_conv->size() + m_conv->workSize();
+    } else {
+        return m_n;
+    }
+}
+
+Complex
+Plan1D::twiddle (Long t, int sign) const noexcept
+{
+    AMREX_ASSERT(t < m_n);
+    Complex const& c = m_twiddle[t];
+    return (sign < 0) ? c : conj(c);
+}
+
+void
+Plan1D::transform (Complex* a, Complex* work, int sign) const
+{
+    if (m_conv)
+    {
+        const int m = m_conv->size();
+        Complex* b = work;
+        // The backward transform is the conjugate of the forward transform
+        // of the conjugate.
+        for (int t = 0; t < m_n; ++t) {
+            b[t] = ((sign < 0) ? a[t] : conj(a[t])) * m_chirp[t];
+        }
+        for (int t = m_n; t < m; ++t) {
+            b[t] = Complex(0.,0.);
+        }
+        m_conv->forward(b, work+m);
+        for (int t = 0; t < m; ++t) {
+            b[t] = b[t] * m_chirp_hat[t];
+        }
+        m_conv->backward(b, work+m);
+        const Real scale = Real(1.)/Real(m);
+        for (int t = 0; t < m_n; ++t) {
+            Complex c = b[t] * m_chirp[t] * scale;
+            a[t] = (sign < 0) ? c : conj(c);
+        }
+    }
+    else if (m_n > 1)
+    {
+        for (int t = 0; t < m_n; ++t) {
+            work[t] = a[t];
+        }
+        cooleyTukey(work, 1, a, m_n, 0, sign);
+    }
+}
+
+// Decimation in time: the transforms of the p interleaved subsequences
+// of in are combined with DFTs of length p.
+void
+Plan1D::cooleyTukey (Complex const* in, int stride, Complex* out, int n, int ifac,
+                     int sign) const
+{
+    if (n == 1) {
+        out[0] = in[0];
+        return;
+    }
+
+    const int p = m_factors[ifac];
+    const int m = n/p;
+    for (int r = 0; r < p; ++r) {
+        cooleyTukey(in + r*stride, stride*p, out + r*m, m, ifac+1, sign);
+    }
+
+    const Long s = m_n/n;
+    if (p == 2)
+    {
+        for (int k = 0; k < m; ++k) {
+            Complex a0 = out[k];
+            Complex a1 = out[k+m] * twiddle(k*s, sign);
+            out[k]   = a0 + a1;
+            out[k+m] = a0 - a1;
+        }
+    }
+    else if (p == 4)
+    {
+        for (int k = 0; k < m; ++k) {
+            Complex a0 = out[k];
+            Complex a1 = out[k+m]   * twiddle(  k*s, sign);
+            Complex a2 = out[k+2*m] * twiddle(2*k*s, sign);
+            Complex a3 = out[k+3*m] * twiddle(3*k*s, sign);
+            Complex t0 = a0 + a2;
+            Complex t1 = a0 - a2;
+            Complex t2 = a1 + a3;
+            Complex d = a1 - a3;
+            // d times exp(sign*i*pi/2)
+            Complex t3 = (sign < 0) ? Complex(d.imag(), -d.real()) : Complex(-d.imag(), d.real());
+            out[k]     = t0 + t2;
+            out[k+m]   = t1 + t3;
+            out[k+2*m] = t0 - t2;
+            out[k+3*m] = t1 - t3;
+        }
+    }
+    else
+    {
+        Complex wp[max_radix];
+        for (int t = 0; t < p; ++t) {
+            wp[t] = twiddle(t*m*s, sign);
+        }
+        Complex tmp[max_radix];
+        for (int k = 0; k < m; ++k) {
+            tmp[0] = out[k];
+            for (int r = 1; r < p; ++r) {
+                tmp[r] = out[r*m+k] * twiddle(Long(r)*k*s, sign);
+            }
+            for (int q = 0; q < p; ++q) {
+                Complex sum = tmp[0];
+                for (int r = 1; r < p; ++r) {
+                    sum += tmp[r] * wp[(r*q) % p];
+                }
+                out[k+q*m] = sum;
+            }
+        }
+    }
+}
+
+BoxArray
+makePencils (Box const& domain, int dir, int nprocs)
+{
+#if (AMREX_SPACEDIM == 1)
+    amrex::ignore_unused(dir, nprocs);
+    return BoxArray(domain);
+#else
+    const int d1 = (dir == 0) ? 1 : 0;
+    const int len1 = domain.length(d1);
+#if (AMREX_SPACEDIM == 2)
+    const int d2 = d1;
+    const int len2 = 1;
+    int p1 = std::min(nprocs, len1);
+    int p2 = 1;
+#else
+    const int d2 = (dir == 2) ? 1 : 2;
+    const int len2 = domain.length(d2);
+    // Split the other two directions into p1*p2 pieces, as close to
+    // square as the lengths allow.
+    int p1 = 1, p2 = 1;
+    for (int n = static_cast<int>(std::min(Long(nprocs), Long(len1)*len2)); n > 0; --n) {
+        int best = 0;
+        for (int q = 1; q <= n; ++q) {
+            if (n % q == 0 && q <= len1 && n/q <= len2 &&
+                (best == 0 || std::abs(q-n/q) < std::abs(best-n/best))) {
+                best = q;
+            }
+        }
+        if (best > 0) {
+            p1 = best;
+            p2 = n/best;
+            break;
+        }
+    }
+#endif
+
+    BoxList bl;
+    for (int i2 = 0; i2 < p2; ++i2) {
+        for (int i1 = 0; i1 < p1; ++i1) {
+            Box b = domain;
+            b.setSmall(d1, domain.smallEnd(d1) + static_cast<int>(Long(i1)*len1/p1));
+            b.setBig  (d1, domain.smallEnd(d1) + static_cast<int>(Long(i1+1)*len1/p1) - 1);
+            if (d2 != d1) {
+                b.setSmall(d2, domain.smallEnd(d2) + static_cast<int>(Long(i2)*len2/p2));
+                b.setBig  (d2, domain.smallEnd(d2) + static_cast<int>(Long(i2+1)*len2/p2) - 1);
+            }
+            bl.push_back(b);
+        }
+    }
+    return BoxArray(std::move(bl));
+#endif
+}
+
+R2C::R2C (Box const& domain, Array<Boundary,AMREX_SPACEDIM> const& bc)
+    : m_domain(domain), m_bc(bc)
+{
+    AMREX_ALWAYS_ASSERT(domain.ok() && domain.cellCentered());
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    MFInfo info;
+    info.SetArena(The_Pinned_Arena());
+
+    // The pencils of direction idim are extended in the directions up to
+    // idim, so that the reflections are added just before the transform
+    // in each direction.
+    Box ext = domain;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        if (bc[idim] != Boundary::periodic) {
+            ext.growHi(idim, domain.length(idim));
+        }
+        m_plan.emplace_back(ext.length(idim));
+
+        BoxArray ba = makePencils(ext, idim, nprocs);
+        Vector<int> pmap(ba.size());
+        for (int i = 0; i < ba.size(); ++i) { pmap[i] = i; }
+        DistributionMapping dm(std::move(pmap));
+        if (idim == 0) {
+            m_rdata.define(makePencils(domain, 0, nprocs), dm, 1, 0, info);
+        }
+        m_cdata[idim].define(ba, dm, 1, 0, info);
+    }
+    m_spectral_domain = ext;
+}
+
+void
+R2C::forward (MultiFab const& mf, int icomp)
+{
+    BL_PROFILE("FFT::R2C::forward()");
+
+    m_rdata.ParallelCopy(mf, icomp, 0, 1);
+
+    for (MFIter mfi(m_rdata); mfi.isValid(); ++mfi) {
+        auto const& r = m_rdata.const_array(mfi);
+        auto const& c = m_cdata[0].array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            c(i,j,k) = Complex(r(i,j,k), 0.);
+        });
+    }
+    transformLines(0, -1);
+
+    for (int idim = 1; idim < AMREX_SPACEDIM; ++idim) {
+        m_cdata[idim].ParallelCopy(m_cdata[idim-1]);
+        transformLines(idim, -1);
+    }
+}
+
+void
+R2C::backward (MultiFab& mf, int icomp)
+{
+    BL_PROFILE("FFT::R2C::backward()");
+
+    for (int idim = AMREX_SPACEDIM-1; idim > 0; --idim) {
+        transformLines(idim, 1);
+        m_cdata[idim-1].ParallelCopy(m_cdata[idim]);
+    }
+    transformLines(0, 1);
+
+    const Real scale = Real(1.)/static_cast<Real>(m_spectral_domain.d_numPts());
+    for (MFIter mfi(m_rdata); mfi.isValid(); ++mfi) {
+        auto const& r = m_rdata.array(mfi);
+        auto const& c = m_cdata[0].const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            r(i,j,k) = c(i,j,k).real() * scale;
+        });
+    }
+
+    mf.ParallelCopy(m_rdata, 0, icomp, 1);
+}
+
+// Transform all the lines along dir.  Before a forward transform, the
+// lines are extended by reflection in the directions that are not
+// periodic.
+void
+R2C::transformLines (int dir, int sign)
+{
+    cMultiFab& cd = m_cdata[dir];
+    Plan1D const& plan = m_plan[dir];
+    const int n = plan.size();
+    const bool extend = sign < 0 && m_bc[dir] != Boundary::periodic;
+    const bool odd = m_bc[dir] == Boundary::odd;
+    const int nload = extend ? n/2 : n;
+
+    for (MFIter mfi(cd); mfi.isValid(); ++mfi)
+    {
+        auto const& a = cd.array(mfi);
+        const Box& bx = mfi.validbox();
+        AMREX_ASSERT(bx.length(dir) == n);
+        Box lines = bx;
+        lines.setBig(dir, bx.smallEnd(dir));
+        const Long nlines = lines.numPts();
+        const Long stride = (dir == 0) ? Long(1) : ((dir == 1) ? a.jstride : a.kstride);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        {
+            Vector<Complex> line(n);
+            Vector<Complex> work(plan.workSize());
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+            for (Long l = 0; l < nlines; ++l)
+            {
+                auto const iv = lines.atOffset3d(l);
+                Complex* p = a.ptr(iv[0], iv[1], iv[2]);
+                for (int t = 0; t < nload; ++t) {
+                    line[t] = p[t*stride];
+                }
+                if (extend) {
+                    for (int t = n/2; t < n; ++t) {
+                        line[t] = odd ? -line[n-1-t] : line[n-1-t];
+                    }
+                }
+                if (sign < 0) {
+                    plan.forward(line.data(), work.data());
+                } else {
+                    plan.backward(line.data(), work.data());
+                }
+                for (int t = 0; t < n; ++t) {
+                    p[t*stride] = line[t];
+                }
+            }
+        }
+    }
+}
+
+}}
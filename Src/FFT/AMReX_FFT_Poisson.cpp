@@ -0,0 +1,75 @@
+#include <AMReX_FFT_Poisson.H>
+#include <AMReX_BLProfiler.H>
+#include <cmath>
+
+namespace amrex {
+namespace FFT {
+
+Poisson::Poisson (Geometry const& geom)
+    : Poisson(geom,
+              {AMREX_D_DECL(LinOpBCType::Periodic,LinOpBCType::Periodic,LinOpBCType::Periodic)},
+              {AMREX_D_DECL(LinOpBCType::Periodic,LinOpBCType::Periodic,LinOpBCType::Periodic)})
+{}
+
+Poisson::Poisson (Geometry const& geom,
+                  Array<LinOpBCType,AMREX_SPACEDIM> const& lobc,
+                  Array<LinOpBCType,AMREX_SPACEDIM> const& hibc)
+    : m_geom(geom),
+      m_r2c(geom.Domain(), fftBoundary(geom, lobc, hibc))
+{}
+
+Array<Boundary,AMREX_SPACEDIM>
+Poisson::fftBoundary (Geometry const& geom,
+                      Array<LinOpBCType,AMREX_SPACEDIM> const& lobc,
+                      Array<LinOpBCType,AMREX_SPACEDIM> const& hibc)
+{
+    Array<Boundary,AMREX_SPACEDIM> r;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+    {
+        if (lobc[idim] != hibc[idim]) {
+            amrex::Abort("FFT::Poisson: the two sides of a direction must have the same boundary type");
+        }
+        if ((lobc[idim] == LinOpBCType::Periodic) != geom.isPeriodic(idim)) {
+            amrex::Abort("FFT::Poisson: periodic boundary types must match the Geometry");
+        }
+        switch (lobc[idim]) {
+        case LinOpBCType::Periodic:  r[idim] = Boundary::periodic; break;
+        case LinOpBCType::Neumann:   r[idim] = Boundary::even;     break;
+        case LinOpBCType::Dirichlet: r[idim] = Boundary::odd;      break;
+        default:
+            amrex::Abort("FFT::Poisson: boundary type must be Periodic, Dirichlet or Neumann");
+        }
+    }
+    return r;
+}
+
+void
+Poisson::solve (MultiFab& soln, MultiFab const& rhs)
+{
+    BL_PROFILE("FFT::Poisson::solve()");
+
+    // Eigenvalues of the second-order Laplacian for each wave number
+    const Box& sdomain = m_r2c.spectralDomain();
+    const Real* dxinv = m_geom.InvCellSize();
+    const Real pi = Real(3.14159265358979323846);
+    Array<Vector<Real>,3> lambda;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const int n = sdomain.length(idim);
+        lambda[idim].resize(n);
+        for (int k = 0; k < n; ++k) {
+            lambda[idim][k] = Real(2.)*(std::cos(Real(2.)*pi*k/n) - Real(1.))
+                * dxinv[idim]*dxinv[idim];
+        }
+    }
+    for (int idim = AMREX_SPACEDIM; idim < 3; ++idim) {
+        lambda[idim].resize(1, Real(0.));
+    }
+
+    m_r2c.forwardThenBackward(rhs, soln, [&] (int i, int j, int k, Complex& c)
+    {
+        Real lam = lambda[0][i] + lambda[1][j] + lambda[2][k];
+        c = (lam != Real(0.)) ? c * (Real(1.)/lam) : Complex(0.,0.);
+    });
+}
+
+}}
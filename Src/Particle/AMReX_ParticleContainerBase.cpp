@@ -164,6 +164,25 @@ Long ParticleContainerBase::MaxParticlesPerRead ()
     return Max_Particles_Per_Read;
 }
 
+bool ParticleContainerBase::ParallelRead ()
+{
+    //
+    // If true, every rank reads its own part of an init file and the
+    // particles are sent to their owners in a single exchange.
+    //
+    static bool Parallel_Read = false;
+    static bool first = true;
+
+    if (first)
+    {
+        first = false;
+        ParmParse pp("particles");
+        pp.query("parallel_read", Parallel_Read);
+    }
+
+    return Parallel_Read;
+}
+
 const std::string& ParticleContainerBase::AggregationType ()
 {
     static std::string aggregation_type;
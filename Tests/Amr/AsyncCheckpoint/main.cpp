@@ -0,0 +1,179 @@
+#include <AMReX.H>
+#include <AMReX_Amr.H>
+#include <AMReX_AsyncOut.H>
+#include <AMReX_LevelBld.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_Print.H>
+#include <AMReX_VisMF.H>
+
+#include <AmrLevelAdv.H>
+
+#include <algorithm>
+#include <array>
+
+using namespace amrex;
+
+amrex::LevelBld* getLevelBld ();
+
+namespace {
+
+// Positions of the tracer particles on this process in the order of their
+// ids.  The ids differ between the two runs, because the id counter is not
+// reset by amrex::Finalize.
+using Particles = Vector<std::array<Real,AMREX_SPACEDIM> >;
+
+// The serial and MPI tests may run at the same time in one directory.
+std::string root_name (const std::string& prefix)
+{
+    return prefix + "_np" + std::to_string(ParallelDescriptor::NProcs()) + "_";
+}
+
+// Runs nsteps steps and writes a checkpoint, returning its name.
+std::string checkpoint (const std::string& root, int nsteps)
+{
+    {
+        ParmParse pp("amr");
+        pp.add("check_file", root);
+    }
+    Amr amr(getLevelBld());
+    amr.init(0.0, -1.0);
+    while (amr.levelSteps(0) < nsteps) {
+        amr.coarseTimeStep(-1.0);
+    }
+    amr.checkPoint();
+    return amrex::Concatenate(root, amr.levelSteps(0), 5);
+}
+
+// Restarts from chkfile, runs to step max_step and writes a plotfile,
+// returning its name.
+std::string restart (const std::string& chkfile, const std::string& root, int max_step,
+                     Particles& particles)
+{
+    {
+        ParmParse pp("amr");
+        pp.add("restart", chkfile);
+        pp.add("plot_file", root);
+    }
+    Amr amr(getLevelBld());
+    amr.init(0.0, -1.0);
+    while (amr.levelSteps(0) < max_step) {
+        amr.coarseTimeStep(-1.0);
+    }
+    amr.writePlotFile();
+
+    particles.clear();
+#ifdef AMREX_PARTICLES
+    if (auto* pc = AmrLevelAdv::theTracerPC()) {
+        Vector<std::pair<std::pair<int,int>,std::array<Real,AMREX_SPACEDIM> > > tmp;
+        for (int lev = 0; lev <= pc->finestLevel(); ++lev) {
+            for (TracerParIter pti(*pc, lev); pti.isValid(); ++pti) {
+                for (auto const& p : pti.GetArrayOfStructs()) {
+                    tmp.push_back({{p.cpu(), p.id()},
+                                   {AMREX_D_DECL(p.pos(0), p.pos(1), p.pos(2))}});
+                }
+            }
+        }
+        std::sort(tmp.begin(), tmp.end());
+        for (auto const& p : tmp) {
+            particles.push_back(p.second);
+        }
+    }
+#endif
+
+    return amrex::Concatenate(root, amr.levelSteps(0), 5);
+}
+
+void async_on ()
+{
+    ParmParse pp("amrex");
+    pp.add("async_out", 1);
+    // Fewer files than processes
+    pp.add("async_out_nfiles", 1);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    // AMReX is initialized twice, without and with async output.
+#ifdef AMREX_USE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    int max_step = 8;
+    const int check_step = 4;
+
+    // Synchronous checkpoint
+    std::string sync_file;
+    amrex::Initialize(argc,argv);
+    {
+        AMREX_ALWAYS_ASSERT(!AsyncOut::UseAsyncOut());
+        sync_file = checkpoint(root_name("chk_sync"), check_step);
+    }
+    amrex::Finalize();
+
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, async_on);
+    {
+        AMREX_ALWAYS_ASSERT(AsyncOut::UseAsyncOut());
+        {
+            ParmParse pp;
+            pp.query("max_step", max_step);
+        }
+
+        const std::string async_file = checkpoint(root_name("chk_async"), check_step);
+
+        // A file written again before the earlier write has finished
+        const std::string mf_name = root_name("mf");
+        {
+            BoxArray ba(Box(IntVect(0), IntVect(31)));
+            ba.maxSize(8);
+            MultiFab mf(ba, DistributionMapping(ba), 2, 0);
+            mf.setVal(1.0);
+            VisMF::AsyncWrite(mf, mf_name);
+            mf.setVal(2.0);
+            VisMF::AsyncWrite(mf, mf_name);
+        }
+        // Finish only waits for the writes of this process.
+        AsyncOut::Finish();
+        ParallelDescriptor::Barrier();
+        {
+            MultiFab mf;
+            VisMF::Read(mf, mf_name);
+            AMREX_ALWAYS_ASSERT(mf.min(0) == 2.0 && mf.max(1) == 2.0);
+        }
+
+        Particles sync_particles, async_particles;
+        const std::string sync_plt = restart(sync_file, root_name("plt_sync"),
+                                             max_step, sync_particles);
+        const std::string async_plt = restart(async_file, root_name("plt_async"),
+                                              max_step, async_particles);
+        AsyncOut::Finish();
+        ParallelDescriptor::Barrier();
+
+        AMREX_ALWAYS_ASSERT(sync_particles == async_particles);
+
+        PlotFileData sync(sync_plt);
+        PlotFileData async(async_plt);
+        AMREX_ALWAYS_ASSERT(sync.finestLevel() == async.finestLevel());
+        for (int lev = 0; lev <= sync.finestLevel(); ++lev) {
+            MultiFab a = sync.get(lev);
+            MultiFab b = async.get(lev);
+            AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray());
+            MultiFab::Subtract(a, b, 0, 0, a.nComp(), 0);
+            for (int n = 0; n < a.nComp(); ++n) {
+                const Real err = a.norm0(n);
+                amrex::Print() << "Level " << lev << " " << sync.varNames()[n]
+                               << ": max difference " << err << "\n";
+                AMREX_ALWAYS_ASSERT(err == 0.);
+            }
+        }
+
+        amrex::Print() << "AsyncCheckpoint: passed\n";
+    }
+    amrex::Finalize();
+
+#ifdef AMREX_USE_MPI
+    MPI_Finalize();
+#endif
+}
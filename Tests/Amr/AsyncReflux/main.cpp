@@ -0,0 +1,209 @@
+#include <AMReX.H>
+#include <AMReX_FluxRegister.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_YAFluxRegister.H>
+#include <cmath>
+#include <memory>
+
+using namespace amrex;
+
+constexpr int ncomp = 3;
+const IntVect ratio(2);
+const Real dt = 0.1;
+
+struct Level
+{
+    Geometry geom;
+    BoxArray ba;
+    DistributionMapping dm;
+    Array<MultiFab,AMREX_SPACEDIM> flux;
+};
+
+Level make_level (const Geometry& geom, const BoxArray& ba, Real shift);
+std::unique_ptr<YAFluxRegister> make_register (const Level& crse, const Level& fine, int nvar);
+void compare (const MultiFab& a, const MultiFab& b);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,0,0)};
+        Geometry cgeom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, is_periodic);
+        Geometry fgeom = amrex::refine(cgeom, ratio);
+
+        BoxArray cba(cgeom.Domain());
+        cba.maxSize(max_grid_size);
+
+        // The fine level touches the periodic boundary.
+        BoxList fbl;
+        fbl.push_back(amrex::refine(Box(IntVect(AMREX_D_DECL(0,n_cell/4,n_cell/4)),
+                                        IntVect(AMREX_D_DECL(n_cell/2-1,n_cell/2,n_cell/2))),
+                                    ratio));
+        fbl.push_back(amrex::refine(Box(IntVect(AMREX_D_DECL(n_cell/2+2,n_cell/4,n_cell/4)),
+                                        IntVect(AMREX_D_DECL(n_cell-1,3*n_cell/4-1,n_cell/2))),
+                                    ratio));
+        BoxArray fba(fbl);
+        fba.maxSize(max_grid_size);
+
+        // Fine grids different from fba, which cannot share the stacked exchange
+        BoxArray fba2(amrex::refine(Box(IntVect(n_cell/4), IntVect(3*n_cell/4-1)), ratio));
+        fba2.maxSize(max_grid_size);
+
+        Level crse = make_level(cgeom, cba, 0.0);
+        Level fine = make_level(fgeom, fba, 0.5);
+        Level fine2 = make_level(fgeom, fba2, 0.25);
+
+        MultiFab state0(cba, crse.dm, 2*ncomp+2, 0);
+        state0.setVal(1.0);
+
+        // Reference: one register at a time
+        MultiFab state_ref(cba, crse.dm, state0.nComp(), 0);
+        MultiFab::Copy(state_ref, state0, 0, 0, state0.nComp(), 0);
+        {
+            Vector<std::unique_ptr<YAFluxRegister> > fr;
+            fr.push_back(make_register(crse, fine, 1));
+            fr.push_back(make_register(crse, fine, 2));
+            fr.push_back(make_register(crse, fine, 3));
+            fr.push_back(make_register(crse, fine2, 2));
+            fr[0]->Reflux(state_ref, 0);
+            fr[1]->Reflux(state_ref, 1);
+            fr[2]->Reflux(state_ref, 3);
+            fr[3]->Reflux(state_ref, 6);
+        }
+        {
+            MultiFab::Subtract(state0, state_ref, 0, 0, state0.nComp(), 0);
+            for (int n = 0; n < state0.nComp(); ++n) {
+                AMREX_ALWAYS_ASSERT(state0.norminf(n) > 0.0);
+            }
+            state0.setVal(1.0);
+        }
+
+        // Non-blocking reflux of each register, all in flight together
+        {
+            MultiFab state(cba, crse.dm, state0.nComp(), 0);
+            MultiFab::Copy(state, state0, 0, 0, state0.nComp(), 0);
+            auto fr0 = make_register(crse, fine, 1);
+            auto fr1 = make_register(crse, fine, 2);
+            auto fr2 = make_register(crse, fine, 3);
+            auto fr3 = make_register(crse, fine2, 2);
+            fr0->Reflux_nowait(state, 0);
+            fr1->Reflux_nowait(state, 1);
+            fr2->Reflux_nowait(state, 3);
+            fr3->Reflux_nowait(state, 6);
+            fr3->Reflux_finish();
+            fr1->Reflux_finish();
+            fr0->Reflux_finish();
+            fr2->Reflux_finish();
+            compare(state, state_ref);
+        }
+
+        // Group reflux with one stacked exchange for the registers on the
+        // same grids, and a group that has to fall back to one exchange
+        // per register.
+        {
+            MultiFab state(cba, crse.dm, state0.nComp(), 0);
+            MultiFab::Copy(state, state0, 0, 0, state0.nComp(), 0);
+            auto fr0 = make_register(crse, fine, 1);
+            auto fr1 = make_register(crse, fine, 2);
+            auto fr2 = make_register(crse, fine, 3);
+            auto fr3 = make_register(crse, fine2, 2);
+            Vector<YAFluxRegister*> stacked{fr0.get(), fr1.get(), fr2.get()};
+            YAFluxRegister::Reflux_nowait(stacked, {&state, &state, &state}, {0, 1, 3});
+            YAFluxRegister::Reflux_finish(stacked);
+            fr3->Reflux(state, 6);
+            compare(state, state_ref);
+
+            MultiFab::Copy(state, state0, 0, 0, state0.nComp(), 0);
+            fr0 = make_register(crse, fine, 1);
+            fr1 = make_register(crse, fine, 2);
+            fr2 = make_register(crse, fine, 3);
+            fr3 = make_register(crse, fine2, 2);
+            Vector<YAFluxRegister*> mixed{fr3.get(), fr0.get(), fr1.get(), fr2.get()};
+            YAFluxRegister::Reflux_nowait(mixed, {&state, &state, &state, &state}, {6, 0, 1, 3});
+            YAFluxRegister::Reflux_finish(mixed);
+            compare(state, state_ref);
+        }
+
+        // FluxRegister::Reflux communicates all faces together.
+        {
+            FluxRegister fr(fba, fine.dm, ratio, 1, ncomp);
+            const Real fine_scale = 1.0/AMREX_D_TERM(Real(ratio[0]),*Real(ratio[1]),*Real(ratio[2]));
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                fr.CrseInit(crse.flux[idim], idim, 0, 0, ncomp, -1.0);
+                fr.FineAdd(fine.flux[idim], idim, 0, 0, ncomp, fine_scale*Real(ratio[idim]));
+            }
+
+            MultiFab volume(cba, crse.dm, 1, 0);
+            const Real* dx = cgeom.CellSize();
+            volume.setVal(AMREX_D_TERM(dx[0],*dx[1],*dx[2]));
+
+            MultiFab a(cba, crse.dm, ncomp, 0);
+            MultiFab b(cba, crse.dm, ncomp, 0);
+            a.setVal(1.0);
+            b.setVal(1.0);
+            fr.Reflux(a, volume, 1.0, 0, 0, ncomp, cgeom);
+            for (OrientationIter fi; fi; ++fi) {
+                fr.Reflux(b, volume, fi(), 1.0, 0, 0, ncomp, cgeom);
+            }
+            compare(a, b);
+        }
+
+        amrex::Print() << "Async reflux: passed\n";
+    }
+    amrex::Finalize();
+}
+
+Level make_level (const Geometry& geom, const BoxArray& ba, Real shift)
+{
+    Level r{geom, ba, DistributionMapping(ba), {}};
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r.flux[idim].define(amrex::convert(ba, IntVect::TheDimensionVector(idim)), r.dm, ncomp, 0);
+        for (MFIter mfi(r.flux[idim]); mfi.isValid(); ++mfi) {
+            auto const& a = r.flux[idim].array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), ncomp, [&] (int i, int j, int k, int n) noexcept
+            {
+                a(i,j,k,n) = std::sin(0.3*i + 0.1*n + shift) + (idim+1)*std::cos(0.2*j) + 0.05*k;
+            });
+        }
+    }
+    return r;
+}
+
+std::unique_ptr<YAFluxRegister> make_register (const Level& crse, const Level& fine, int nvar)
+{
+    auto fr = std::make_unique<YAFluxRegister>(fine.ba, crse.ba, fine.dm, crse.dm,
+                                               fine.geom, crse.geom, ratio, 1, nvar);
+    fr->reset();
+    for (MFIter mfi(crse.ba, crse.dm); mfi.isValid(); ++mfi) {
+        fr->CrseAdd(mfi, {AMREX_D_DECL(&crse.flux[0][mfi], &crse.flux[1][mfi], &crse.flux[2][mfi])},
+                    crse.geom.CellSize(), dt, RunOn::Host);
+    }
+    for (int step = 0; step < ratio[0]; ++step) {
+        for (MFIter mfi(fine.ba, fine.dm); mfi.isValid(); ++mfi) {
+            fr->FineAdd(mfi, {AMREX_D_DECL(&fine.flux[0][mfi], &fine.flux[1][mfi], &fine.flux[2][mfi])},
+                        fine.geom.CellSize(), dt/ratio[0], RunOn::Host);
+        }
+    }
+    return fr;
+}
+
+void compare (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), a.nComp(), 0);
+    MultiFab::Copy(diff, a, 0, 0, a.nComp(), 0);
+    MultiFab::Subtract(diff, b, 0, 0, a.nComp(), 0);
+    for (int n = 0; n < a.nComp(); ++n) {
+        AMREX_ALWAYS_ASSERT(diff.norminf(n) == 0.0);
+    }
+}
@@ -0,0 +1,130 @@
+#include <AMReX.H>
+#include <AMReX_FillPatchUtil.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_Print.H>
+#include <cmath>
+
+using namespace amrex;
+
+constexpr int ncomp = 3;
+const IntVect ratio(2);
+
+void fill (MultiFab& mf, Real shift);
+void fillpatch (MultiFab& mf, MultiFab& cmf, MultiFab& fmf,
+                const Geometry& cgeom, const Geometry& fgeom);
+void compare (const MultiFab& a, const MultiFab& b, Real scale);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry cgeom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, is_periodic);
+        Geometry fgeom = amrex::refine(cgeom, ratio);
+
+        BoxArray cba(cgeom.Domain());
+        cba.maxSize(max_grid_size);
+        MultiFab cmf(cba, DistributionMapping(cba), ncomp, 0);
+        fill(cmf, 0.0);
+
+        auto& stats = FabArrayBase::m_FPinfo_stats;
+        const Long nerase = stats.nerase;
+
+        {
+            BoxList fbl;
+            fbl.push_back(amrex::refine(Box(IntVect(n_cell/4), IntVect(n_cell/2-1)), ratio));
+            fbl.push_back(amrex::refine(Box(IntVect(n_cell/2), IntVect(3*n_cell/4-1)), ratio));
+            BoxArray fba(fbl);
+            fba.maxSize(max_grid_size);
+            DistributionMapping fdm(fba);
+            MultiFab fmf(fba, fdm, ncomp, 0);
+            fill(fmf, 0.5);
+
+            MultiFab ref(fba, fdm, ncomp, 2);
+            fillpatch(ref, cmf, fmf, cgeom, fgeom);
+            const Long miss = stats.ntmpmiss;
+            const Long hit = stats.ntmphit;
+            AMREX_ALWAYS_ASSERT(miss >= 2);
+
+            // The temporaries are reused, and what they held before must
+            // not leak into the result.  Scaling by 2 is exact.
+            cmf.mult(2.0);
+            fmf.mult(2.0);
+            MultiFab mf(fba, fdm, ncomp, 2);
+            fillpatch(mf, cmf, fmf, cgeom, fgeom);
+            compare(mf, ref, 2.0);
+            AMREX_ALWAYS_ASSERT(stats.ntmpmiss == miss);
+            AMREX_ALWAYS_ASSERT(stats.ntmphit >= hit+2);
+            cmf.mult(0.5);
+        }
+
+        // The temporaries go away with the fine grids, and after a regrid
+        // they are built for the new grids.
+        AMREX_ALWAYS_ASSERT(stats.nerase > nerase);
+        {
+            const Long miss = stats.ntmpmiss;
+            BoxArray fba(amrex::refine(Box(IntVect(n_cell/8), IntVect(n_cell/2+3)), ratio));
+            fba.maxSize(max_grid_size);
+            DistributionMapping fdm(fba);
+            MultiFab fmf(fba, fdm, ncomp, 0);
+            fill(fmf, 0.25);
+            MultiFab mf(fba, fdm, ncomp, 2);
+            fillpatch(mf, cmf, fmf, cgeom, fgeom);
+            AMREX_ALWAYS_ASSERT(stats.ntmpmiss > miss);
+        }
+
+        amrex::Print() << "FillPatch cache: " << stats.ntmphit << " hits, "
+                       << stats.ntmpmiss << " misses: passed\n";
+    }
+    amrex::Finalize();
+}
+
+void fill (MultiFab& mf, Real shift)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), ncomp, [&] (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = std::sin(0.3*i + 0.1*n + shift) + std::cos(0.2*j) + 0.05*k;
+        });
+    }
+}
+
+void fillpatch (MultiFab& mf, MultiFab& cmf, MultiFab& fmf,
+                const Geometry& cgeom, const Geometry& fgeom)
+{
+    Vector<BCRec> bcs(ncomp);
+    for (auto& bc : bcs) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bc.setLo(idim, BCType::int_dir);
+            bc.setHi(idim, BCType::int_dir);
+        }
+    }
+    PhysBCFunctNoOp bcf;
+    amrex::FillPatchTwoLevels(mf, mf.nGrowVect(), 0.0, {&cmf}, {0.0}, {&fmf}, {0.0},
+                              0, 0, ncomp, cgeom, fgeom, bcf, 0, bcf, 0, ratio,
+                              &cell_cons_interp, bcs, 0);
+}
+
+void compare (const MultiFab& a, const MultiFab& b, Real scale)
+{
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        auto const& x = a.const_array(mfi);
+        auto const& y = b.const_array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), ncomp, [&] (int i, int j, int k, int n) noexcept
+        {
+            AMREX_ALWAYS_ASSERT(x(i,j,k,n) == scale*y(i,j,k,n));
+        });
+    }
+}
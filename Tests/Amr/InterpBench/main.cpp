@@ -0,0 +1,201 @@
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_Interpolater.H>
+#include <AMReX_MFInterp_C.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <cmath>
+#include <string>
+
+using namespace amrex;
+
+const IntVect ratio(2);
+
+void fill (FArrayBox& fab);
+void two_pass_interp (const FArrayBox& crse, FArrayBox& fine, int ncomp, const Box& fine_region,
+                      const Box& cdomain, Vector<BCRec> const& bcr, bool lin_limit);
+void compare (const FArrayBox& a, const FArrayBox& b, const Box& bx, int ncomp);
+void check_conservation (const FArrayBox& crse, const FArrayBox& fine, const Box& fine_region,
+                         int ncomp);
+
+template <typename F>
+double seconds_per_call (int nrep, F&& f)
+{
+    f();
+    const double t0 = amrex::second();
+    for (int irep = 0; irep < nrep; ++irep) {
+        f();
+    }
+    return (amrex::second() - t0) / nrep;
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int ncomp = 20;
+        int nrep = 20;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("ncomp", ncomp);
+            pp.query("nrep", nrep);
+        }
+
+        // The fine region touches the low end of the domain, where the
+        // boundary is physical.
+        const Box fine_region(IntVect(0), IntVect(n_cell-1));
+        const Box cdomain(IntVect(0), IntVect(n_cell));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Geometry cgeom(cdomain, rb, 0, {AMREX_D_DECL(0,0,0)});
+        Geometry fgeom = amrex::refine(cgeom, ratio);
+
+        Vector<BCRec> bcr(ncomp);
+        for (auto& bc : bcr) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                bc.setLo(idim, BCType::ext_dir);
+                bc.setHi(idim, BCType::hoextrap);
+            }
+        }
+
+        // A region that sticks out of the domain on both ends, so that the
+        // physical boundaries are inside the rows of coarse cells.
+        const Box straddle = amrex::grow(amrex::refine(cdomain,ratio), 4);
+
+        FArrayBox crse(amrex::grow(amrex::coarsen(straddle,ratio),2), ncomp);
+        fill(crse);
+        FArrayBox fine(straddle, ncomp);
+        FArrayBox fine_ref(straddle, ncomp);
+
+        auto interp = [&] (Interpolater& mapper, const Box& bx) {
+            mapper.interp(crse, 0, fine, 0, ncomp, bx, ratio, cgeom, fgeom, bcr,
+                          0, 0, RunOn::Host);
+        };
+
+        // The fused kernels give the same results as the slopes computed
+        // into a temporary, also for fine regions that cover coarse cells
+        // only partially.
+        for (const Box& bx : {fine_region, amrex::grow(fine_region,-1), straddle}) {
+            fine.setVal<RunOn::Host>(0.0);
+            fine_ref.setVal<RunOn::Host>(0.0);
+            interp(cell_cons_interp, bx);
+            two_pass_interp(crse, fine_ref, ncomp, bx, cdomain, bcr, false);
+            compare(fine, fine_ref, bx, ncomp);
+
+            interp(lincc_interp, bx);
+            two_pass_interp(crse, fine_ref, ncomp, bx, cdomain, bcr, true);
+            compare(fine, fine_ref, bx, ncomp);
+        }
+
+        interp(cell_cons_interp, fine_region);
+        check_conservation(crse, fine, fine_region, ncomp);
+        interp(lincc_interp, fine_region);
+        check_conservation(crse, fine, fine_region, ncomp);
+        interp(quartic_interp, fine_region);
+        check_conservation(crse, fine, fine_region, ncomp);
+
+        const double nfine = static_cast<double>(fine_region.d_numPts());
+        auto report = [&] (std::string const& name, double t) {
+            amrex::Print() << "  " << name << ": " << t/nfine*1.e9 << " ns per fine cell, "
+                           << t/(nfine*ncomp)*1.e9 << " ns per fine cell and component\n";
+        };
+        amrex::Print() << "Interpolation of " << ncomp << " components to "
+                       << fine_region << "\n";
+        report("two-pass conservative linear (mc limiter)  ",
+               seconds_per_call(nrep, [&] () {
+                   two_pass_interp(crse, fine_ref, ncomp, fine_region, cdomain, bcr, false);
+               }));
+        report("CellConservativeLinear (mc limiter)        ",
+               seconds_per_call(nrep, [&] () { interp(cell_cons_interp, fine_region); }));
+        report("two-pass conservative linear (lin limiter) ",
+               seconds_per_call(nrep, [&] () {
+                   two_pass_interp(crse, fine_ref, ncomp, fine_region, cdomain, bcr, true);
+               }));
+        report("CellConservativeLinear (lin limiter)       ",
+               seconds_per_call(nrep, [&] () { interp(lincc_interp, fine_region); }));
+        report("CellConservativeQuartic                    ",
+               seconds_per_call(nrep, [&] () { interp(quartic_interp, fine_region); }));
+#if (AMREX_SPACEDIM == 2)
+        report("CellQuadratic                              ",
+               seconds_per_call(nrep, [&] () { interp(quadratic_interp, fine_region); }));
+#endif
+        report("CellBilinear                               ",
+               seconds_per_call(nrep, [&] () { interp(cell_bilinear_interp, fine_region); }));
+        report("PCInterp                                   ",
+               seconds_per_call(nrep, [&] () { interp(pc_interp, fine_region); }));
+
+        amrex::Print() << "Interpolater benchmark: passed\n";
+    }
+    amrex::Finalize();
+}
+
+// Smooth data with a jump in the middle to exercise the limiters
+void fill (FArrayBox& fab)
+{
+    auto const& a = fab.array();
+    const int imid = fab.box().length(0)/2;
+    amrex::LoopOnCpu(fab.box(), fab.nComp(), [&] (int i, int j, int k, int n) noexcept
+    {
+        a(i,j,k,n) = std::sin(0.3*i + 0.1*n) + std::cos(0.2*j + 0.05*n*n) + 0.05*k
+            + ((i > imid) ? 1.0 : 0.0);
+    });
+}
+
+void two_pass_interp (const FArrayBox& crse, FArrayBox& fine, int ncomp, const Box& fine_region,
+                      const Box& cdomain, Vector<BCRec> const& bcr, bool lin_limit)
+{
+    const Box& cslope_bx = amrex::coarsen(fine_region, ratio);
+    FArrayBox slopefab(cslope_bx, ncomp*AMREX_SPACEDIM);
+    Array4<Real> const& slope = slopefab.array();
+    Array4<Real const> const& cslope = slopefab.const_array();
+    Array4<Real const> const& c = crse.const_array();
+    Array4<Real> const& f = fine.array();
+    BCRec const* bcrp = bcr.data();
+    if (lin_limit) {
+        AMREX_HOST_DEVICE_PARALLEL_FOR_3D_FLAG(RunOn::Host, cslope_bx, i, j, k,
+        {
+            mf_cell_cons_lin_interp_llslope(i,j,k, slope, c, 0, ncomp, cdomain, bcrp);
+        });
+    } else {
+        AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(RunOn::Host, cslope_bx, ncomp, i, j, k, n,
+        {
+            mf_cell_cons_lin_interp_mcslope(i,j,k,n, slope, c, 0, ncomp, cdomain, ratio, bcrp);
+        });
+    }
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(RunOn::Host, fine_region, ncomp, i, j, k, n,
+    {
+        mf_cell_cons_lin_interp(i,j,k,n, f, 0, cslope, c, 0, ncomp, ratio);
+    });
+}
+
+void compare (const FArrayBox& a, const FArrayBox& b, const Box& bx, int ncomp)
+{
+    auto const& x = a.const_array();
+    auto const& y = b.const_array();
+    amrex::LoopOnCpu(bx, ncomp, [&] (int i, int j, int k, int n) noexcept
+    {
+        AMREX_ALWAYS_ASSERT(x(i,j,k,n) == y(i,j,k,n));
+    });
+}
+
+// The average of the fine cells is the coarse value.
+void check_conservation (const FArrayBox& crse, const FArrayBox& fine, const Box& fine_region,
+                         int ncomp)
+{
+    auto const& c = crse.const_array();
+    auto const& f = fine.const_array();
+    const Real vol = AMREX_D_TERM(Real(ratio[0]),*Real(ratio[1]),*Real(ratio[2]));
+    Real err = 0.;
+    amrex::LoopOnCpu(amrex::coarsen(fine_region,ratio), ncomp,
+                     [&] (int ic, int jc, int kc, int n) noexcept
+    {
+        const Box fbx = amrex::refine(Box(IntVect(AMREX_D_DECL(ic,jc,kc)),
+                                          IntVect(AMREX_D_DECL(ic,jc,kc))), ratio);
+        Real sum = 0.;
+        amrex::LoopOnCpu(fbx, [&] (int i, int j, int k) noexcept { sum += f(i,j,k,n); });
+        err = std::max(err, std::abs(sum/vol - c(ic,jc,kc,n)));
+    });
+    AMREX_ALWAYS_ASSERT(err < 1.e-12);
+}
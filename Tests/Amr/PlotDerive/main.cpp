@@ -0,0 +1,191 @@
+#include <AMReX.H>
+#include <AMReX_Amr.H>
+#include <AMReX_LevelBld.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_Print.H>
+
+#include <AmrLevelAdv.H>
+
+using namespace amrex;
+
+namespace {
+
+int num_single_derive = 0;
+
+// AmrLevelAdv with an override of the single-name derive, as applications
+// do to compute some quantities themselves.
+class AmrLevelTest
+    :
+    public AmrLevelAdv
+{
+public:
+    AmrLevelTest () = default;
+    AmrLevelTest (Amr& papa, int lev, const Geometry& level_geom,
+                  const BoxArray& ba, const DistributionMapping& dm, Real time)
+        : AmrLevelAdv(papa, lev, level_geom, ba, dm, time) {}
+
+    using AmrLevel::derive;
+
+    virtual void derive (const std::string& name, Real time,
+                         MultiFab& mf, int dcomp) override
+    {
+        ++num_single_derive;
+        AmrLevelAdv::derive(name, time, mf, dcomp);
+    }
+};
+
+void phi_sq (const Box& bx, FArrayBox& derfab, int dcomp, int /*ncomp*/,
+             const FArrayBox& datafab, const Geometry& /*geom*/,
+             Real /*time*/, const int* /*bcrec*/, int /*level*/)
+{
+    auto const& p = datafab.const_array();
+    auto const& d = derfab.array(dcomp);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        d(i,j,k) = p(i,j,k)*p(i,j,k);
+    });
+}
+
+void phi_grad (const Box& bx, FArrayBox& derfab, int dcomp, int /*ncomp*/,
+               const FArrayBox& datafab, const Geometry& geom,
+               Real /*time*/, const int* /*bcrec*/, int /*level*/)
+{
+    auto const& p = datafab.const_array();
+    auto const& g = derfab.array(dcomp);
+    const auto dxinv = geom.InvCellSizeArray();
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        AMREX_D_TERM(g(i,j,k,0) = 0.5*dxinv[0]*(p(i+1,j,k)-p(i-1,j,k));,
+                     g(i,j,k,1) = 0.5*dxinv[1]*(p(i,j+1,k)-p(i,j-1,k));,
+                     g(i,j,k,2) = 0.5*dxinv[2]*(p(i,j,k+1)-p(i,j,k-1)));
+    });
+}
+
+void phi_wide (const Box& bx, FArrayBox& derfab, int dcomp, int /*ncomp*/,
+               const FArrayBox& datafab, const Geometry& /*geom*/,
+               Real /*time*/, const int* /*bcrec*/, int /*level*/)
+{
+    auto const& p = datafab.const_array();
+    auto const& d = derfab.array(dcomp);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        d(i,j,k) = AMREX_D_TERM(p(i-2,j,k)+p(i+2,j,k),
+                               +p(i,j-2,k)+p(i,j+2,k),
+                               +p(i,j,k-2)+p(i,j,k+2)) - (2*AMREX_SPACEDIM)*p(i,j,k);
+    });
+}
+
+Box grow_by_two (const Box& box) noexcept
+{
+    return amrex::grow(box, 2);
+}
+
+class LevelBldTest
+    :
+    public LevelBld
+{
+    virtual void variableSetUp () override
+    {
+        AmrLevelAdv::variableSetUp();
+
+        DeriveList& derive_lst = AmrLevel::get_derive_lst();
+        const DescriptorList& desc_lst = AmrLevel::get_desc_lst();
+        derive_lst.add("phi_sq", IndexType::TheCellType(), 1,
+                       phi_sq, DeriveRec::TheSameBox);
+        derive_lst.addComponent("phi_sq", desc_lst, Phi_Type, 0, 1);
+        derive_lst.add("phi_grad", IndexType::TheCellType(), AMREX_SPACEDIM,
+                       phi_grad, DeriveRec::GrowBoxByOne);
+        derive_lst.addComponent("phi_grad", desc_lst, Phi_Type, 0, 1);
+        derive_lst.add("phi_wide", IndexType::TheCellType(), 1,
+                       phi_wide, grow_by_two);
+        derive_lst.addComponent("phi_wide", desc_lst, Phi_Type, 0, 1);
+    }
+
+    virtual void variableCleanUp () override
+    {
+        AmrLevel::get_derive_lst().clear();
+        AmrLevelAdv::variableCleanUp();
+    }
+
+    virtual AmrLevel* operator() () override
+    {
+        return new AmrLevelTest;
+    }
+
+    virtual AmrLevel* operator() (Amr& papa, int lev, const Geometry& level_geom,
+                                  const BoxArray& ba, const DistributionMapping& dm,
+                                  Real time) override
+    {
+        return new AmrLevelTest(papa, lev, level_geom, ba, dm, time);
+    }
+};
+
+LevelBldTest test_bld;
+
+// Runs a few steps and writes a plotfile, returning its name.
+std::string run (bool batch)
+{
+    // The serial and MPI tests may run at the same time in one directory.
+    const std::string root = std::string(batch ? "plt_batch" : "plt_single")
+        + "_np" + std::to_string(ParallelDescriptor::NProcs()) + "_";
+    {
+        ParmParse pp("amr");
+        pp.add("plot_batch_derive", static_cast<int>(batch));
+        pp.add("plot_file", root);
+    }
+
+    int max_step = 2;
+    {
+        ParmParse pp;
+        pp.query("max_step", max_step);
+    }
+
+    Amr amr(&test_bld);
+    amr.init(0.0, -1.0);
+    while (amr.levelSteps(0) < max_step) {
+        amr.coarseTimeStep(-1.0);
+    }
+
+    num_single_derive = 0;
+    amr.writePlotFile();
+    if (batch) {
+        AMREX_ALWAYS_ASSERT(num_single_derive == 0);
+    } else {
+        // All the derived quantities go through the override.
+        AMREX_ALWAYS_ASSERT(num_single_derive == 3*(amr.finestLevel()+1));
+    }
+
+    return amrex::Concatenate(root, amr.levelSteps(0), 5);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const std::string single_file = run(false);
+        const std::string batch_file = run(true);
+
+        PlotFileData single(single_file);
+        PlotFileData batch(batch_file);
+        AMREX_ALWAYS_ASSERT(single.finestLevel() == batch.finestLevel() &&
+                            single.varNames() == batch.varNames());
+        for (int lev = 0; lev <= single.finestLevel(); ++lev) {
+            MultiFab a = single.get(lev);
+            MultiFab b = batch.get(lev);
+            AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray());
+            MultiFab::Subtract(a, b, 0, 0, a.nComp(), 0);
+            for (int n = 0; n < a.nComp(); ++n) {
+                const Real err = a.norm0(n);
+                amrex::Print() << "Level " << lev << " " << single.varNames()[n]
+                               << ": max difference " << err << "\n";
+                AMREX_ALWAYS_ASSERT(err == 0.);
+            }
+        }
+
+        amrex::Print() << "PlotDerive: passed\n";
+    }
+    amrex::Finalize();
+}
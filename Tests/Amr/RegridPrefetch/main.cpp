@@ -0,0 +1,73 @@
+#include <AMReX.H>
+#include <AMReX_Amr.H>
+#include <AMReX_LevelBld.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+amrex::LevelBld* getLevelBld ();
+
+namespace {
+
+// Runs max_step steps with regrids and writes a plotfile, returning its name.
+std::string run (bool prefetch)
+{
+    // The serial and MPI tests may run at the same time in one directory.
+    const std::string root = std::string(prefetch ? "plt_prefetch" : "plt_direct")
+        + "_np" + std::to_string(ParallelDescriptor::NProcs()) + "_";
+    {
+        ParmParse pp("amr");
+        pp.add("regrid_prefetch", static_cast<int>(prefetch));
+        pp.add("plot_file", root);
+    }
+
+    int max_step = 6;
+    {
+        ParmParse pp;
+        pp.query("max_step", max_step);
+    }
+
+    Amr amr(getLevelBld());
+    amr.init(0.0, -1.0);
+    const BoxArray ba0 = amr.boxArray(amr.finestLevel());
+    while (amr.levelSteps(0) < max_step) {
+        amr.coarseTimeStep(-1.0);
+    }
+    // The fine grids have moved with the vortex.
+    AMREX_ALWAYS_ASSERT(amr.finestLevel() > 0 && amr.boxArray(amr.finestLevel()) != ba0);
+
+    amr.writePlotFile();
+    return amrex::Concatenate(root, amr.levelSteps(0), 5);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const std::string direct_file = run(false);
+        const std::string prefetch_file = run(true);
+
+        PlotFileData direct(direct_file);
+        PlotFileData prefetch(prefetch_file);
+        AMREX_ALWAYS_ASSERT(direct.finestLevel() == prefetch.finestLevel());
+        for (int lev = 0; lev <= direct.finestLevel(); ++lev) {
+            MultiFab a = direct.get(lev);
+            MultiFab b = prefetch.get(lev);
+            AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray());
+            MultiFab::Subtract(a, b, 0, 0, a.nComp(), 0);
+            for (int n = 0; n < a.nComp(); ++n) {
+                const Real err = a.norm0(n);
+                amrex::Print() << "Level " << lev << " " << direct.varNames()[n]
+                               << ": max difference " << err << "\n";
+                AMREX_ALWAYS_ASSERT(err == 0.);
+            }
+        }
+
+        amrex::Print() << "RegridPrefetch: passed\n";
+    }
+    amrex::Finalize();
+}
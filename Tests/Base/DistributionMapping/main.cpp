@@ -0,0 +1,115 @@
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <string>
+
+using namespace amrex;
+
+BoxArray make_shell (int n_cell, int max_grid_size);
+void check (const BoxArray& ba, DistributionMapping::Strategy how, const std::string& name);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        BoxArray uniform(Box(IntVect(0), IntVect(n_cell-1)));
+        uniform.maxSize(max_grid_size);
+        const BoxArray shell = make_shell(n_cell, max_grid_size);
+
+        for (auto how : {DistributionMapping::RCB, DistributionMapping::GRAPH}) {
+            const std::string name = (how == DistributionMapping::RCB) ? "RCB" : "GRAPH";
+            check(uniform, how, name + " uniform");
+            check(shell, how, name + " shell");
+        }
+
+        amrex::Print() << "DistributionMapping: passed\n";
+    }
+    amrex::Finalize();
+}
+
+// The boxes of a uniform grid whose centers are in a spherical shell
+BoxArray make_shell (int n_cell, int max_grid_size)
+{
+    BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+    ba.maxSize(max_grid_size);
+    BoxList bl;
+    for (int i = 0; i < ba.size(); ++i) {
+        const Box& bx = ba[i];
+        Real r2 = 0.;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            const Real x = Real(bx.smallEnd(idim)+bx.bigEnd(idim)+1)/(2*n_cell) - Real(0.5);
+            r2 += x*x;
+        }
+        if (r2 > Real(0.25*0.25) && r2 < Real(0.45*0.45)) {
+            bl.push_back(bx);
+        }
+    }
+    return BoxArray(std::move(bl));
+}
+
+void check (const BoxArray& ba, DistributionMapping::Strategy how, const std::string& name)
+{
+    const int nboxes = ba.size();
+
+    // With the number of processes of this run, through the strategy
+    const int nprocs = ParallelDescriptor::NProcs();
+    DistributionMapping::strategy(how);
+    const DistributionMapping dm(ba);
+    DistributionMapping::strategy(DistributionMapping::SFC);
+    const auto& pmap = dm.ProcessorMap();
+    AMREX_ALWAYS_ASSERT(static_cast<int>(pmap.size()) == nboxes);
+    Vector<int> nboxes_on(nprocs, 0);
+    for (int p : pmap) {
+        AMREX_ALWAYS_ASSERT(p >= 0 && p < nprocs);
+        ++nboxes_on[p];
+    }
+    for (int n : nboxes_on) {
+        AMREX_ALWAYS_ASSERT(n > 0);
+    }
+
+    // Every process computes the same map.
+    Vector<int> pmin(pmap.begin(), pmap.end());
+    Vector<int> pmax(pmap.begin(), pmap.end());
+    ParallelAllReduce::Min(pmin.data(), nboxes, ParallelDescriptor::Communicator());
+    ParallelAllReduce::Max(pmax.data(), nboxes, ParallelDescriptor::Communicator());
+    AMREX_ALWAYS_ASSERT(pmin == pmax);
+
+    // With more processes than there are in this run.  The boxes are
+    // weighted by their number of cells.
+    std::vector<Long> wgts;
+    for (int i = 0; i < nboxes; ++i) {
+        wgts.push_back(ba[i].numPts());
+    }
+    for (int np : {8, 64}) {
+        Real eff = 0., eff2 = 0.;
+        DistributionMapping dm1, dm2;
+        if (how == DistributionMapping::RCB) {
+            dm1.RCBProcessorMap(ba, wgts, np, &eff);
+            dm2.RCBProcessorMap(ba, wgts, np, &eff2);
+        } else {
+            dm1.GraphProcessorMap(ba, wgts, np, &eff);
+            dm2.GraphProcessorMap(ba, wgts, np, &eff2);
+        }
+        // The map is deterministic, and each box is assigned to one process.
+        AMREX_ALWAYS_ASSERT(dm1.ProcessorMap() == dm2.ProcessorMap() && eff == eff2);
+        AMREX_ALWAYS_ASSERT(static_cast<int>(dm1.ProcessorMap().size()) == nboxes);
+        for (int p : dm1.ProcessorMap()) {
+            AMREX_ALWAYS_ASSERT(p >= 0 && p < np);
+        }
+        amrex::Print() << "  " << name << ": " << nboxes << " boxes on " << np
+                       << " processes, efficiency " << eff << "\n";
+        AMREX_ALWAYS_ASSERT(eff > 0.8);
+    }
+}
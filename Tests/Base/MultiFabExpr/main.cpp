@@ -0,0 +1,142 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MultiFabExpr.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+void fill (MultiFab& mf, Real shift);
+void compare (const MultiFab& a, const MultiFab& b, int ngrow, Real tol);
+void compare (Real a, Real b, Real tol);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        const int ncomp = 3;
+        const int ngrow = 1;
+        const Real tol = 1.e-14;
+        // The sums are taken in a different order.
+        const Real rtol = 1.e-12;
+        const Real a = 0.3;
+        const Real b = -1.7;
+
+        MultiFab x(ba, dm, ncomp, ngrow);
+        MultiFab y(ba, dm, ncomp, ngrow);
+        MultiFab z(ba, dm, ncomp, ngrow);
+        MultiFab ref(ba, dm, ncomp, ngrow);
+        MultiFab res(ba, dm, ncomp, ngrow);
+        fill(x, 1.0);
+        fill(y, 2.0);
+        fill(z, 3.0);
+
+        // Arithmetic on other types is not affected by the operators.
+        static_assert(std::is_same<decltype(1+2), int>::value, "");
+        static_assert(std::is_same<decltype(IntVect(1)+IntVect(2)), IntVect>::value, "");
+
+        // Assignment vs LinComb
+        res.setVal(0.0);
+        ref.setVal(0.0);
+        res = a*x + b*y;
+        MultiFab::LinComb(ref, a, x, 0, b, y, 0, 0, ncomp, 0);
+        compare(res, ref, 0, tol);
+
+        // EvalExpr with ghost cells and component offsets vs LinComb
+        EvalExpr(res, 1, 2, IntVect(ngrow), a*MFExprComp(x,0) + b*MFExprComp(y,1));
+        MultiFab::LinComb(ref, a, x, 0, b, y, 1, 1, 2, ngrow);
+        compare(res, ref, ngrow, tol);
+
+        // The destination in the expression vs Saxpy
+        MultiFab::Copy(res, z, 0, 0, ncomp, ngrow);
+        MultiFab::Copy(ref, z, 0, 0, ncomp, ngrow);
+        EvalExpr(res, 0, ncomp, IntVect(ngrow), res + a*x);
+        MultiFab::Saxpy(ref, a, x, 0, 0, ncomp, ngrow);
+        compare(res, ref, ngrow, tol);
+
+        // Products, quotients and negation vs Multiply, Divide and mult
+        res = -(x*y/z) - 2.0;
+        MultiFab::Copy(ref, x, 0, 0, ncomp, 0);
+        MultiFab::Multiply(ref, y, 0, 0, ncomp, 0);
+        MultiFab::Divide(ref, z, 0, 0, ncomp, 0);
+        ref.mult(-1.0, 0, ncomp);
+        ref.plus(-2.0, 0, ncomp);
+        compare(res, ref, 0, tol);
+
+        // Reading other components of the destination is detected.
+        AMREX_ALWAYS_ASSERT((a*MFExprComp(res,1)).overlaps(res, 0, 2));
+        AMREX_ALWAYS_ASSERT(!(a*MFExprComp(res,2)).overlaps(res, 0, 2));
+        AMREX_ALWAYS_ASSERT(!(res + a*x).overlaps(res, 0, ncomp));
+
+        // Fused reductions vs Dot and norms
+        for (int n = 0; n < ncomp; ++n) {
+            compare(ExprSum(MFExprComp(x,n)*MFExprComp(y,n), 1),
+                    MultiFab::Dot(x, n, y, n, 1, 0), rtol);
+        }
+        compare(ExprSum(x*y, ncomp, IntVect(ngrow)),
+                MultiFab::Dot(x, 0, y, 0, ncomp, ngrow), rtol);
+
+        Real nm0 = EvalExprNorm0(res, 0, ncomp, x - b*y);
+        MultiFab::LinComb(ref, 1.0, x, 0, -b, y, 0, 0, ncomp, 0);
+        compare(res, ref, 0, tol);
+        compare(nm0, ref.norm0(0, ncomp, IntVect(0)), tol);
+
+        Real nm2 = EvalExprNorm2(res, 0, ncomp, a*x*y);
+        Real ref2 = 0.;
+        for (int n = 0; n < ncomp; ++n) {
+            MultiFab::Copy(ref, x, n, n, 1, 0);
+            MultiFab::Multiply(ref, y, n, n, 1, 0);
+            ref.mult(a, n, 1);
+            ref2 += std::pow(ref.norm2(n), 2);
+        }
+        compare(res, ref, 0, tol);
+        compare(nm2, std::sqrt(ref2), rtol);
+
+        amrex::Print() << "MultiFabExpr: passed\n";
+    }
+    amrex::Finalize();
+}
+
+void fill (MultiFab& mf, Real shift)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), mf.nComp(), [&] (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = shift + std::sin(0.1*i + 0.2*j + 0.3*k + n + shift);
+        });
+    }
+}
+
+void compare (const MultiFab& a, const MultiFab& b, int ngrow, Real tol)
+{
+    Real err = 0.;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.growntilebox(ngrow);
+        auto const& x = a.const_array(mfi);
+        auto const& y = b.const_array(mfi);
+        amrex::LoopOnCpu(bx, a.nComp(), [&] (int i, int j, int k, int n) noexcept
+        {
+            err = std::max(err, std::abs(x(i,j,k,n)-y(i,j,k,n)));
+        });
+    }
+    ParallelDescriptor::ReduceRealMax(err);
+    AMREX_ALWAYS_ASSERT(err <= tol);
+}
+
+void compare (Real a, Real b, Real tol)
+{
+    AMREX_ALWAYS_ASSERT(std::abs(a-b) <= tol*std::max(std::abs(a),std::abs(b)));
+}
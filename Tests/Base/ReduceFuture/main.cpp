@@ -0,0 +1,132 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Reduce.H>
+
+using namespace amrex;
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const MPI_Comm comm = ParallelDescriptor::Communicator();
+        const int myproc = ParallelDescriptor::MyProc();
+
+        const Real rv = 1.5 + myproc;
+        const int iv = 10 - myproc;
+        const Long lv = 1000 + myproc;
+        const Vector<Real> vv{Real(myproc), Real(-myproc), 0.25};
+        const Vector<int> ivv{myproc, 2*myproc+1};
+
+        // Several reductions in flight at once
+        auto fmax = ParallelAllReduce::Max_nowait(rv, comm);
+        auto fmin = ParallelAllReduce::Min_nowait(iv, comm);
+        auto fsum = ParallelAllReduce::Sum_nowait(lv, comm);
+        auto fvsum = ParallelAllReduce::Sum_nowait(vv, comm);
+        auto fvmax = ParallelAllReduce::Max_nowait(ivv, comm);
+        auto fvmin = ParallelAllReduce::Min_nowait(vv, comm);
+
+        while (!fmax.test()) {}
+        AMREX_ALWAYS_ASSERT(fmax.test());
+
+        Real rmax = rv;
+        ParallelAllReduce::Max(rmax, comm);
+        int imin = iv;
+        ParallelAllReduce::Min(imin, comm);
+        Long lsum = lv;
+        ParallelAllReduce::Sum(lsum, comm);
+        Vector<Real> vsum = vv;
+        ParallelAllReduce::Sum(vsum.data(), vsum.size(), comm);
+        Vector<int> ivmax = ivv;
+        ParallelAllReduce::Max(ivmax.data(), ivmax.size(), comm);
+        Vector<Real> vmin = vv;
+        ParallelAllReduce::Min(vmin.data(), vmin.size(), comm);
+
+        AMREX_ALWAYS_ASSERT(fmax.get() == rmax);
+        AMREX_ALWAYS_ASSERT(fmin.get() == imin);
+        AMREX_ALWAYS_ASSERT(fsum.get() == lsum);
+        AMREX_ALWAYS_ASSERT(fvsum.get() == vsum);
+        AMREX_ALWAYS_ASSERT(fvmax.get() == ivmax);
+        AMREX_ALWAYS_ASSERT(fvmin.get() == vmin);
+        // get() can be called again
+        AMREX_ALWAYS_ASSERT(fmax.get() == rmax && fmax.test());
+
+        // Move construction and move assignment onto a pending future,
+        // which waits for the reduction it replaces.
+        {
+            auto f1 = ParallelAllReduce::Sum_nowait(rv, comm);
+            auto f2 = std::move(f1);
+            AMREX_ALWAYS_ASSERT(f1.test());
+            f2 = ParallelAllReduce::Max_nowait(rv, comm);
+            AMREX_ALWAYS_ASSERT(f2.get() == rmax);
+            ReduceFuture<Real> f3;
+            AMREX_ALWAYS_ASSERT(f3.test());
+            f3 = ParallelAllReduce::Sum_nowait(rv, comm);
+            Real rsum = rv;
+            ParallelAllReduce::Sum(rsum, comm);
+            AMREX_ALWAYS_ASSERT(f3.get() == rsum);
+        }
+
+        // Destruction of a pending future completes it, so the reductions
+        // after it still match up across the ranks.
+        {
+            auto f = ParallelAllReduce::Min_nowait(lv, comm);
+        }
+        {
+            Long l = lv;
+            ParallelAllReduce::Max(l, comm);
+            AMREX_ALWAYS_ASSERT(l == 1000 + ParallelDescriptor::NProcs() - 1);
+        }
+
+        // ReduceOps and ReduceData on a MultiFab
+        int n_cell = 32;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        MultiFab mf(ba, DistributionMapping(ba), 1, 0);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            auto const& a = mf.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                a(i,j,k) = Real(i - 2*j + 3*k);
+            });
+        }
+
+        // value() combines the per-thread results in place, so each
+        // ReduceData is only reduced once.
+        ReduceOps<ReduceOpSum, ReduceOpMax, ReduceOpMin> reduce_op;
+        ReduceData<Real, Real, Real> reduce_data(reduce_op);
+        ReduceData<Real, Real, Real> reduce_data_2(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        for (auto* rd : {&reduce_data, &reduce_data_2}) {
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                auto const& a = mf.const_array(mfi);
+                reduce_op.eval(mfi.validbox(), *rd,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    return { a(i,j,k), a(i,j,k), a(i,j,k) };
+                });
+            }
+        }
+        auto fop = reduce_op.value_nowait(reduce_data, comm);
+        auto fdata = reduce_data_2.value_nowait(comm);
+        ReduceTuple const& rop = fop.get();
+        ReduceTuple const& rdata = fdata.get();
+        AMREX_ALWAYS_ASSERT(amrex::get<0>(rop) == mf.sum() &&
+                            amrex::get<1>(rop) == mf.max(0) &&
+                            amrex::get<2>(rop) == mf.min(0));
+        AMREX_ALWAYS_ASSERT(amrex::get<0>(rdata) == amrex::get<0>(rop) &&
+                            amrex::get<1>(rdata) == amrex::get<1>(rop) &&
+                            amrex::get<2>(rdata) == amrex::get<2>(rop));
+
+        amrex::Print() << "ReduceFuture: passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,149 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_ShmArena.H>
+
+using namespace amrex;
+
+void fill (MultiFab& mf);
+void compare (const MultiFab& a, const MultiFab& b);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        const Periodicity period{IntVect(n_cell)};
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        const int ncomp = 3;
+        const int ngrow = 2;
+
+        // shm holds its data in node shared memory if fabarray.shm_comm is
+        // on, and mpi always communicates through MPI.
+        MultiFab shm(ba, dm, ncomp, ngrow);
+        MultiFab mpi(ba, dm, ncomp, ngrow, MFInfo().SetArena(The_Cpu_Arena()));
+        const bool use_shm = shm.ShmCommReady();
+        AMREX_ALWAYS_ASSERT(!mpi.ShmCommReady());
+        amrex::Print() << "Shared memory communication: " << use_shm << "\n";
+        if (The_Shm_Arena()) {
+            AMREX_ALWAYS_ASSERT(use_shm);
+        }
+
+        // FillBoundary, blocking and non-blocking
+        fill(shm);
+        fill(mpi);
+        shm.FillBoundary(period);
+        mpi.FillBoundary(period);
+        compare(shm, mpi);
+
+        fill(shm);
+        fill(mpi);
+        shm.FillBoundary_nowait(1, 2, IntVect(1), period);
+        shm.FillBoundary_finish();
+        mpi.FillBoundary_nowait(1, 2, IntVect(1), period);
+        mpi.FillBoundary_finish();
+        compare(shm, mpi);
+
+        // ParallelCopy into a different BoxArray, including ghost cells.
+        // The ghost cells of the source must be consistent, because with
+        // COPY the order of the overlapping copies is not specified.
+        shm.FillBoundary(period);
+        mpi.FillBoundary(period);
+        BoxArray ba2(domain);
+        ba2.maxSize(max_grid_size*3/2);
+        DistributionMapping dm2(ba2);
+        MultiFab dst_shm(ba2, dm2, ncomp, 1);
+        MultiFab dst_mpi(ba2, dm2, ncomp, 1);
+        for (int op = 0; op < 2; ++op) {
+            dst_shm.setVal(1.0);
+            dst_mpi.setVal(1.0);
+            const auto cop = (op == 0) ? FabArrayBase::COPY : FabArrayBase::ADD;
+            dst_shm.ParallelCopy(shm, 0, 0, ncomp, IntVect(1), IntVect(1), period, cop);
+            dst_mpi.ParallelCopy(mpi, 0, 0, ncomp, IntVect(1), IntVect(1), period, cop);
+            compare(dst_shm, dst_mpi);
+        }
+
+        // A FabArray that has used shared memory, filled again inside a
+        // subcommunicator that does not contain all the ranks of the node.
+        // This must not use shared memory, which would synchronize the
+        // whole node.
+        Vector<int> pmap(ba.size(), 0);
+        DistributionMapping dm0(pmap);
+        MultiFab own(ba, dm0, ncomp, ngrow);
+        MultiFab own_ref(ba, dm0, ncomp, ngrow, MFInfo().SetArena(The_Cpu_Arena()));
+        fill(own);
+        own.FillBoundary(period);
+        AMREX_ALWAYS_ASSERT(own.ShmCommReady() == use_shm);
+        fill(own_ref);
+        own_ref.FillBoundary(period);
+#ifdef BL_USE_MPI
+        const int myproc = ParallelDescriptor::MyProc();
+        MPI_Comm subcomm;
+        MPI_Comm_split(ParallelDescriptor::Communicator(), myproc, myproc, &subcomm);
+        ParallelContext::push(subcomm);
+        AMREX_ALWAYS_ASSERT(!own.ShmCommReady());
+        if (myproc == 0) {
+            fill(own);
+            own.FillBoundary(period);
+            for (MFIter mfi(own); mfi.isValid(); ++mfi) {
+                auto const& x = own.const_array(mfi);
+                auto const& y = own_ref.const_array(mfi);
+                amrex::LoopOnCpu(mfi.fabbox(), ncomp, [&] (int i, int j, int k, int n) noexcept
+                {
+                    AMREX_ALWAYS_ASSERT(x(i,j,k,n) == y(i,j,k,n));
+                });
+            }
+        }
+        ParallelContext::pop();
+        MPI_Comm_free(&subcomm);
+#endif
+        AMREX_ALWAYS_ASSERT(own.ShmCommReady() == use_shm);
+        fill(own);
+        own.FillBoundary(period);
+        compare(own, own_ref);
+
+        amrex::Print() << "ShmComm: passed\n";
+    }
+    amrex::Finalize();
+}
+
+void fill (MultiFab& mf)
+{
+    mf.setVal(-1.0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), mf.nComp(), [&] (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = 1000.*n + 100.*i + 10.*j + k;
+        });
+    }
+}
+
+void compare (const MultiFab& a, const MultiFab& b)
+{
+    AMREX_ALWAYS_ASSERT(a.boxArray() == b.boxArray() &&
+                        a.DistributionMap() == b.DistributionMap());
+    Real err = 0.;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        auto const& x = a.const_array(mfi);
+        auto const& y = b.const_array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), a.nComp(), [&] (int i, int j, int k, int n) noexcept
+        {
+            err = std::max(err, std::abs(x(i,j,k,n)-y(i,j,k,n)));
+        });
+    }
+    ParallelDescriptor::ReduceRealMax(err);
+    AMREX_ALWAYS_ASSERT(err == 0.);
+}
@@ -0,0 +1,196 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_TimeIntegrator.H>
+
+#include <cmath>
+
+using namespace amrex;
+
+// dS0/dt = cos(t)*S0 and dS1/dt = -S1^2, so S0(t) = S0(0)*exp(sin(t)) and
+// S1(t) = S1(0)/(1+S1(0)*t).
+void rhs (MultiFab& f, MultiFab const& S, Real t);
+void init (MultiFab& S, Real t);
+Real error (MultiFab const& S, Real t);
+Real integrate (MultiFab& S, TimeIntegrator<MultiFab>& integrator, Real dt, int nsteps);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 16;
+        int max_grid_size = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        MultiFab S(ba, dm, 2, 0);
+
+        const Real T = 1.0;
+        const int nsteps = 16;
+
+        // The observed order of each method from the errors at T with dt
+        // and dt/2.  It may be higher than the order of the method before
+        // the leading error term dominates, e.g., for DormandPrince.
+        for (std::string name : {"ForwardEuler", "Trapezoid", "SSPRK3", "RK4",
+                                 "HeunEuler", "BogackiShampine", "DormandPrince",
+                                 "Williamson3", "CarpenterKennedy4", "SSPRK3_3Sstar"})
+        {
+            TimeIntegrator<MultiFab> integrator(S, RKTableau::make(name));
+            const int p = integrator.tableau().order;
+            const Real e1 = integrate(S, integrator, T/nsteps, nsteps);
+            const Real e2 = integrate(S, integrator, T/(2*nsteps), 2*nsteps);
+            const Real order = std::log2(e1/e2);
+            amrex::Print() << name << ": errors " << e1 << " " << e2
+                           << ", order " << order << " (" << p << ")\n";
+            AMREX_ALWAYS_ASSERT(order > p-0.3 && order < p+1.);
+
+            // The error estimate of one step is the local error of the
+            // embedded method.
+            if (integrator.hasErrorEstimate()) {
+                integrator.set_tolerances(1.0, 0.0);
+                const int q = integrator.tableau().embedded_order;
+                integrate(S, integrator, 0.04, 1);
+                const Real est1 = integrator.errorEstimate();
+                integrate(S, integrator, 0.02, 1);
+                const Real est2 = integrator.errorEstimate();
+                const Real est_order = std::log2(est1/est2);
+                amrex::Print() << name << ": error estimates " << est1 << " " << est2
+                               << ", order " << est_order << " (" << q+1 << ")\n";
+                AMREX_ALWAYS_ASSERT(std::abs(est_order-(q+1)) < 0.3);
+            }
+        }
+
+        // The relative error estimate is scaled by the new solution.  With
+        // a uniform solution it is the absolute estimate divided by |S_new|.
+        for (std::string name : {"BogackiShampine", "SSPRK3_3Sstar"})
+        {
+            MultiFab S0(ba, dm, 1, 0);
+            MultiFab S1(ba, dm, 1, 0);
+            TimeIntegrator<MultiFab> integrator(S0, RKTableau::make(name));
+            integrator.set_rhs([] (MultiFab& f, MultiFab& s, Real) {
+                MultiFab::Copy(f, s, 0, 0, 1, 0);
+                f.mult(-3.0);
+            });
+            S0.setVal(2.0);
+            integrator.set_tolerances(1.0, 0.0);
+            integrator.advance(S0, S1, 0.0, 0.5);
+            const Real est_abs = integrator.errorEstimate();
+            integrator.set_tolerances(0.0, 1.0);
+            integrator.advance(S0, S1, 0.0, 0.5);
+            const Real est_rel = integrator.errorEstimate();
+            const Real snew = S1.max(0);
+            AMREX_ALWAYS_ASSERT(S1.min(0) == snew);
+            AMREX_ALWAYS_ASSERT(std::abs(est_rel*snew - est_abs) <= 1.e-12*est_abs);
+        }
+
+        // A User method from ParmParse matches the built-in one.
+        {
+            RKTableau w = RKTableau::make("Williamson3");
+            ParmParse pp("user2n");
+            pp.add("type", std::string("User"));
+            pp.add("form", std::string("2N"));
+            pp.add("order", w.order);
+            pp.addarr("c", std::vector<Real>(w.c.begin(), w.c.end()));
+            pp.addarr("A", std::vector<Real>(w.A.begin(), w.A.end()));
+            pp.addarr("B", std::vector<Real>(w.B.begin(), w.B.end()));
+
+            MultiFab S2(ba, dm, 2, 0);
+            TimeIntegrator<MultiFab> builtin(S, w);
+            TimeIntegrator<MultiFab> user(S2, "user2n");
+            AMREX_ALWAYS_ASSERT(user.tableau().form == RKTableau::Form::LowStorage2N);
+            integrate(S, builtin, 0.1, 3);
+            integrate(S2, user, 0.1, 3);
+            MultiFab::Subtract(S2, S, 0, 0, 2, 0);
+            AMREX_ALWAYS_ASSERT(S2.norm0(0) == 0. && S2.norm0(1) == 0.);
+        }
+
+        // Vector<MultiFab> gives the same result as each MultiFab.
+        for (std::string name : {"RK4", "Williamson3", "SSPRK3_3Sstar", "DormandPrince"})
+        {
+            Vector<MultiFab> Sv(2);
+            Vector<MultiFab> Snew(2);
+            for (int lev = 0; lev < 2; ++lev) {
+                Sv[lev].define(ba, dm, 2, 0);
+                Snew[lev].define(ba, dm, 2, 0);
+                init(Sv[lev], 0.0);
+            }
+            Sv[1].mult(0.5);
+            TimeIntegrator<Vector<MultiFab> > vintegrator(Sv, RKTableau::make(name));
+            vintegrator.set_rhs([] (Vector<MultiFab>& f, Vector<MultiFab>& s, Real t) {
+                for (int lev = 0; lev < 2; ++lev) { rhs(f[lev], s[lev], t); }
+            });
+            vintegrator.advance(Sv, Snew, 0.0, 0.1);
+
+            TimeIntegrator<MultiFab> integrator(S, RKTableau::make(name));
+            integrator.set_rhs([] (MultiFab& f, MultiFab& s, Real t) { rhs(f, s, t); });
+            Real err = 0.;
+            for (int lev = 0; lev < 2; ++lev) {
+                MultiFab S1(ba, dm, 2, 0);
+                integrator.advance(Sv[lev], S1, 0.0, 0.1);
+                err = std::max(err, integrator.errorEstimate());
+                MultiFab::Subtract(S1, Snew[lev], 0, 0, 2, 0);
+                AMREX_ALWAYS_ASSERT(S1.norm0(0) == 0. && S1.norm0(1) == 0.);
+            }
+            AMREX_ALWAYS_ASSERT(vintegrator.errorEstimate() == err);
+        }
+
+        amrex::Print() << "TimeIntegrator: passed\n";
+    }
+    amrex::Finalize();
+}
+
+void rhs (MultiFab& f, MultiFab const& S, Real t)
+{
+    const Real ct = std::cos(t);
+    for (MFIter mfi(f); mfi.isValid(); ++mfi) {
+        auto const& fa = f.array(mfi);
+        auto const& sa = S.const_array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            fa(i,j,k,0) = ct*sa(i,j,k,0);
+            fa(i,j,k,1) = -sa(i,j,k,1)*sa(i,j,k,1);
+        });
+    }
+}
+
+void init (MultiFab& S, Real t)
+{
+    for (MFIter mfi(S); mfi.isValid(); ++mfi) {
+        auto const& sa = S.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const Real s0 = 1.0 + 0.1*i;
+            const Real s1 = 0.5 + 0.05*j + 0.02*k;
+            sa(i,j,k,0) = s0*std::exp(std::sin(t));
+            sa(i,j,k,1) = s1/(1.0+s1*t);
+        });
+    }
+}
+
+Real error (MultiFab const& S, Real t)
+{
+    MultiFab exact(S.boxArray(), S.DistributionMap(), S.nComp(), 0);
+    init(exact, t);
+    MultiFab::Subtract(exact, S, 0, 0, S.nComp(), 0);
+    return exact.norm0(0, S.nComp(), IntVect(0));
+}
+
+Real integrate (MultiFab& S, TimeIntegrator<MultiFab>& integrator, Real dt, int nsteps)
+{
+    integrator.set_rhs([] (MultiFab& f, MultiFab& s, Real t) { rhs(f, s, t); });
+    MultiFab S_new(S.boxArray(), S.DistributionMap(), S.nComp(), 0);
+    init(S, 0.0);
+    Real time = 0.0;
+    for (int step = 0; step < nsteps; ++step) {
+        time = integrator.advance(S, S_new, time, dt);
+        std::swap(S, S_new);
+    }
+    return error(S, time);
+}
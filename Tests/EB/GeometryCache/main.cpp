@@ -0,0 +1,182 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF_Sphere.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+#include <AMReX_FileSystem.H>
+#include <memory>
+
+using namespace amrex;
+
+struct EBData
+{
+    Vector<Geometry> geom;
+    Vector<BoxArray> grids;
+    Vector<DistributionMapping> dmap;
+    Vector<std::unique_ptr<EBFArrayBoxFactory> > factory;
+};
+
+EB2::GeometryShop<EB2::SphereIF> make_gshop ();
+EBData make_ebdata (const Geometry& geom, int nlevs, int max_grid_size);
+EBData make_ebdata (const EBData& layout);
+void compare (const EBData& a, const EBData& b);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int nlevs = 3;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nlevs", nlevs);
+        }
+
+        std::string cache_dir;
+        {
+            ParmParse pp("eb2");
+            pp.get("cache_dir", cache_dir);
+            // The serial and MPI tests may run at the same time in one
+            // directory, and each starts from an empty cache.
+            cache_dir += "_np" + std::to_string(ParallelDescriptor::NProcs());
+            pp.add("cache_dir", cache_dir);
+        }
+        if (ParallelDescriptor::IOProcessor() && FileSystem::Exists(cache_dir)) {
+            FileSystem::RemoveAll(cache_dir);
+        }
+        ParallelDescriptor::Barrier();
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,1)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, is_periodic);
+
+        // Cache miss: the geometry is computed from the implicit function
+        // and the finest level is written to eb2.cache_dir.
+        EB2::Build(geom, nlevs-1, nlevs-1);
+        EBData built = make_ebdata(geom, nlevs, max_grid_size);
+        const std::string cache_name = EB2::GeometryCacheName(make_gshop(), geom, nlevs-1);
+        AMREX_ALWAYS_ASSERT(FileSystem::Exists(cache_name+"/Header"));
+
+        // Cache hit: all levels are restored from the cached finest level.
+        // The new IndexSpace goes on top of the stack, the first one is
+        // still referenced by the factories in built.
+        EB2::Build(geom, nlevs-1, nlevs-1);
+        AMREX_ALWAYS_ASSERT(dynamic_cast<EB2::IndexSpaceChkptFile const*>
+                            (&EB2::IndexSpace::top()) != nullptr);
+        EBData loaded = make_ebdata(built);
+        compare(built, loaded);
+
+        // Any change to the eb2 parameters selects a different cache entry.
+        {
+            ParmParse pp("eb2");
+            Real r;
+            pp.get("sphere_radius", r);
+            pp.add("sphere_radius", r*1.01);
+            AMREX_ALWAYS_ASSERT(EB2::GeometryCacheName(make_gshop(), geom, nlevs-1) != cache_name);
+        }
+
+        amrex::Print() << "EB2 geometry cache: passed\n";
+    }
+    amrex::Finalize();
+}
+
+EB2::GeometryShop<EB2::SphereIF> make_gshop ()
+{
+    ParmParse pp("eb2");
+    RealArray center;
+    Real radius;
+    bool has_fluid_inside;
+    pp.get("sphere_center", center);
+    pp.get("sphere_radius", radius);
+    pp.get("sphere_has_fluid_inside", has_fluid_inside);
+    return EB2::makeShop(EB2::SphereIF(radius, center, has_fluid_inside));
+}
+
+EBData make_ebdata (const Geometry& geom, int nlevs, int max_grid_size)
+{
+    EBData r;
+    for (int lev = 0; lev < nlevs; ++lev) {
+        r.geom.push_back(lev == 0 ? geom : amrex::coarsen(r.geom.back(),2));
+        r.grids.emplace_back(r.geom[lev].Domain());
+        r.grids[lev].maxSize(max_grid_size);
+        r.dmap.emplace_back(r.grids[lev]);
+    }
+    return make_ebdata(r);
+}
+
+// Factories from the top IndexSpace on the same grids as layout
+EBData make_ebdata (const EBData& layout)
+{
+    EBData r;
+    r.geom = layout.geom;
+    r.grids = layout.grids;
+    r.dmap = layout.dmap;
+    const EB2::IndexSpace& ebis = EB2::IndexSpace::top();
+    for (int lev = 0; lev < static_cast<int>(r.geom.size()); ++lev) {
+        r.factory.push_back(std::make_unique<EBFArrayBoxFactory>(
+                                ebis.getLevel(r.geom[lev]), r.geom[lev],
+                                r.grids[lev], r.dmap[lev],
+                                Vector<int>{2,2,2}, EBSupport::full));
+    }
+    return r;
+}
+
+void compare (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrow());
+    MultiFab::Copy(diff, a, 0, 0, a.nComp(), a.nGrow());
+    MultiFab::Subtract(diff, b, 0, 0, a.nComp(), a.nGrow());
+    for (int n = 0; n < a.nComp(); ++n) {
+        AMREX_ALWAYS_ASSERT(diff.norminf(n, a.nGrow()) == 0.0);
+    }
+}
+
+void compare (const MultiCutFab& a, const MultiCutFab& b)
+{
+    compare(a.ToMultiFab(0.,0.), b.ToMultiFab(0.,0.));
+}
+
+void compare (const EBData& a, const EBData& b)
+{
+    for (int lev = 0; lev < static_cast<int>(a.factory.size()); ++lev)
+    {
+        const auto& fa = *a.factory[lev];
+        const auto& fb = *b.factory[lev];
+
+        const auto& flaga = fa.getMultiEBCellFlagFab();
+        const auto& flagb = fb.getMultiEBCellFlagFab();
+        Long ndiff = 0;
+        for (MFIter mfi(flaga); mfi.isValid(); ++mfi) {
+            AMREX_ALWAYS_ASSERT(flaga[mfi].getType() == flagb[mfi].getType());
+            const Box& bx = mfi.fabbox();
+            auto const& x = flaga.const_array(mfi);
+            auto const& y = flagb.const_array(mfi);
+            amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                if (x(i,j,k) != y(i,j,k)) { ++ndiff; }
+            });
+        }
+        ParallelDescriptor::ReduceLongSum(ndiff);
+        AMREX_ALWAYS_ASSERT(ndiff == 0);
+
+        compare(fa.getVolFrac(), fb.getVolFrac());
+        compare(fa.getCentroid(), fb.getCentroid());
+        compare(fa.getBndryArea(), fb.getBndryArea());
+        compare(fa.getBndryCent(), fb.getBndryCent());
+        compare(fa.getBndryNormal(), fb.getBndryNormal());
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            compare(*fa.getAreaFrac()[idim], *fb.getAreaFrac()[idim]);
+            compare(*fa.getFaceCent()[idim], *fb.getFaceCent()[idim]);
+            compare(*fa.getEdgeCent()[idim], *fb.getEdgeCent()[idim]);
+        }
+
+        amrex::Print() << "  level " << lev << " " << fa.getVolFrac().boxArray().size()
+                       << " grids: identical\n";
+    }
+}
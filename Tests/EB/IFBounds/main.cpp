@@ -0,0 +1,163 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB2_IF.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Parser.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <chrono>
+#include <string>
+
+using namespace amrex;
+
+int n_cell = 128;
+int nboxes = 2000;
+
+// Box classification by sampling the nodes as done without bounds
+template <class F>
+int sample_box_type (F const& f, const Box& bx, const Geometry& geom)
+{
+    const Real* problo = geom.ProbLo();
+    const Real* dx = geom.CellSize();
+    const auto lo = amrex::lbound(bx);
+    const auto hi = amrex::ubound(bx);
+    int nbody = 0, nfluid = 0;
+    for         (int k = lo.z; k <= hi.z; ++k) {
+        for     (int j = lo.y; j <= hi.y; ++j) {
+            for (int i = lo.x; i <= hi.x; ++i) {
+                Real v = f(RealArray{AMREX_D_DECL(problo[0]+i*dx[0],
+                                                  problo[1]+j*dx[1],
+                                                  problo[2]+k*dx[2])});
+                if (v > 0.0) {
+                    ++nbody;
+                } else if (v < 0.0) {
+                    ++nfluid;
+                }
+                if (nbody > 0 && nfluid > 0) {
+                    return EB2::GeometryShop<F>::mixedcells;
+                }
+            }
+        }
+    }
+    if (nbody == 0) {
+        return EB2::GeometryShop<F>::allregular;
+    } else {
+        return EB2::GeometryShop<F>::allcovered;
+    }
+}
+
+template <class F>
+void test_if (const std::string& name, F const& f, const Geometry& geom)
+{
+    auto gshop = EB2::makeShop(f);
+    const Box& nddomain = amrex::surroundingNodes(geom.Domain());
+
+    // Random node boxes of up to 64 nodes per side, and the boxes of a
+    // grid layout like the one used by EB2::Build.
+    Vector<Box> boxes;
+    for (int n = 0; n < nboxes; ++n) {
+        IntVect lo, hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            int len = 1 + amrex::Random_int(64);
+            lo[idim] = amrex::Random_int(n_cell+2-len);
+            hi[idim] = lo[idim] + len - 1;
+        }
+        boxes.push_back(Box(lo,hi,IndexType::TheNodeType()));
+    }
+    BoxList bl(geom.Domain());
+    bl.maxSize(32);
+    for (auto const& b : bl) {
+        boxes.push_back(amrex::surroundingNodes(amrex::grow(b,1)) & nddomain);
+    }
+
+    // The bounds must contain the values on all nodes.
+    Long nbounded = 0;
+    for (auto const& bx : boxes) {
+        EB2::Interval bounds = gshop.getBounds(bx, geom);
+        if (std::isfinite(bounds.lo) || std::isfinite(bounds.hi)) { ++nbounded; }
+        const Real* problo = geom.ProbLo();
+        const Real* dx = geom.CellSize();
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j,k);
+            Real v = f(RealArray{AMREX_D_DECL(problo[0]+i*dx[0],
+                                              problo[1]+j*dx[1],
+                                              problo[2]+k*dx[2])});
+            AMREX_ALWAYS_ASSERT(v >= bounds.lo && v <= bounds.hi);
+        });
+    }
+
+    Vector<int> box_type(boxes.size());
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < boxes.size(); ++i) {
+        box_type[i] = gshop.getBoxType(boxes[i], geom, RunOn::Cpu);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < boxes.size(); ++i) {
+        AMREX_ALWAYS_ASSERT(box_type[i] == sample_box_type(f, boxes[i], geom));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    amrex::Print() << "  " << name << ": " << nbounded << " of " << boxes.size()
+                   << " boxes bounded, getBoxType " << std::chrono::duration<double>(t1-t0).count()
+                   << " s, sampling " << std::chrono::duration<double>(t2-t1).count() << " s\n";
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("nboxes", nboxes);
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, {AMREX_D_DECL(0,0,0)});
+
+        EB2::SphereIF sphere(0.3, {AMREX_D_DECL(0.5,0.5,0.5)}, false);
+        EB2::PlaneIF plane({AMREX_D_DECL(0.5,0.5,0.5)}, {AMREX_D_DECL(0.3,-1.0,0.2)});
+        EB2::BoxIF box({AMREX_D_DECL(0.2,0.3,0.25)}, {AMREX_D_DECL(0.7,0.6,0.8)}, false);
+        EB2::CylinderIF cylinder(0.2, 0.6, 1, {AMREX_D_DECL(0.5,0.5,0.5)}, false);
+        EB2::CylinderIF pipe(0.3, 0, {AMREX_D_DECL(0.5,0.5,0.5)}, true);
+
+        Vector<EB2::PolyTerm> poly{ {1.0, IntVect(AMREX_D_DECL(2,0,0))},
+                                    {1.0, IntVect(AMREX_D_DECL(0,3,0))},
+                                    {-0.5, IntVect(AMREX_D_DECL(1,1,0))},
+                                    {-0.2, IntVect(0)} };
+        EB2::PolynomialIF polynomial(poly, false);
+
+        amrex::Print() << "Testing bounds of implicit functions\n";
+
+        test_if("sphere", sphere, geom);
+        test_if("plane", plane, geom);
+        test_if("box", box, geom);
+        test_if("cylinder", cylinder, geom);
+        test_if("infinite cylinder", pipe, geom);
+        test_if("polynomial", polynomial, geom);
+        test_if("union", EB2::makeUnion(sphere, cylinder, box), geom);
+        test_if("intersection", EB2::makeIntersection(sphere, box), geom);
+        test_if("difference", EB2::makeDifference(box, sphere), geom);
+        test_if("complement", EB2::makeComplement(cylinder), geom);
+        test_if("translated and rotated",
+                EB2::rotate(EB2::translate(box, {AMREX_D_DECL(-0.5,-0.5,-0.5)}), 0.4, 2), geom);
+        // An ellipsoid has no bounds, so only the box can decide.
+        test_if("union with unbounded",
+                EB2::makeUnion(box, EB2::EllipsoidIF({AMREX_D_DECL(0.1,0.2,0.1)},
+                                                     {AMREX_D_DECL(0.5,0.5,0.5)}, false)), geom);
+
+        Vector<std::string> exprs
+            {"-((x-0.5)^2+(y-0.5)^2+(z-0.5)^2-0.09)",
+             "r=sqrt((x-0.5)**2+(y-0.5)**2); 0.05*sin(12*atan((y-0.5)/(x-0.4999))) + 0.3 - r",
+             "if(x<0.5, 0.3-sqrt((x-0.5)^2+(y-0.5)^2+(z-0.5)^2), max(abs(y-0.5),abs(z-0.5))-0.3)",
+             "exp(-10*((x-0.5)^2+(y-0.5)^2)) - 0.5 + 0.1*cos(7*z) + log(1+x) - tanh(y)"};
+        for (auto const& expr : exprs) {
+            Parser parser(expr);
+            parser.registerVariables({"x","y","z"});
+            EB2::ParserIF pif(parser.compile<3>());
+            test_if("parser " + expr, pif, geom);
+        }
+
+        amrex::Print() << "IF bounds: passed\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,131 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_EBMultiFabUtil.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <cmath>
+#include <memory>
+
+using namespace amrex;
+
+std::unique_ptr<EBFArrayBoxFactory> make_factory (const Geometry& geom, const BoxArray& ba,
+                                                  const DistributionMapping& dm, bool sparse);
+Vector<MultiCutFab const*> cut_data (const EBFArrayBoxFactory& factory);
+void compare (const MultiCutFab& a, const MultiCutFab& b);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, is_periodic);
+        BoxArray ba(geom.Domain());
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        EB2::Build(geom, 0, 0);
+
+        auto dense = make_factory(geom, ba, dm, false);
+        auto sparse = make_factory(geom, ba, dm, true);
+        auto const& dense_data = cut_data(*dense);
+        auto const& sparse_data = cut_data(*sparse);
+
+        // Sparse storage must take less memory and give the same values
+        // through const_view, which ToMultiFab uses.
+        Long dense_bytes = 0, sparse_bytes = 0;
+        for (int i = 0; i < static_cast<int>(dense_data.size()); ++i) {
+            dense_bytes += dense_data[i]->nBytes();
+            sparse_bytes += sparse_data[i]->nBytes();
+            compare(*dense_data[i], *sparse_data[i]);
+        }
+        ParallelDescriptor::ReduceLongSum(dense_bytes);
+        ParallelDescriptor::ReduceLongSum(sparse_bytes);
+        amrex::Print() << "  cut-cell data: dense " << dense_bytes << " bytes, sparse "
+                       << sparse_bytes << " bytes ("
+                       << static_cast<double>(sparse_bytes)/static_cast<double>(dense_bytes)
+                       << ")\n";
+        AMREX_ALWAYS_ASSERT(sparse_bytes < dense_bytes);
+
+        // Kernels taking the view give the same results.
+        MultiFab phi(ba, dm, 1, 1, MFInfo(), *dense);
+        for (MFIter mfi(phi); mfi.isValid(); ++mfi) {
+            auto const& a = phi.array(mfi);
+            const Box& bx = mfi.fabbox();
+            amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                a(i,j,k) = std::sin(0.1*i) + std::cos(0.2*j) + 0.01*k;
+            });
+        }
+        MultiFab cdense(ba, dm, 1, 0, MFInfo(), *dense);
+        MultiFab csparse(ba, dm, 1, 0, MFInfo(), *sparse);
+        EB_interp_CC_to_Centroid(cdense, phi, 0, 0, 1, geom);
+        {
+            MultiFab phis(ba, dm, 1, 1, MFInfo(), *sparse);
+            MultiFab::Copy(phis, phi, 0, 0, 1, 1);
+            EB_interp_CC_to_Centroid(csparse, phis, 0, 0, 1, geom);
+        }
+        MultiFab::Subtract(cdense, csparse, 0, 0, 1, 0);
+        AMREX_ALWAYS_ASSERT(cdense.norminf(0) == 0.0);
+
+        // Dense access brings the data back to dense storage.
+        for (MFIter mfi(sparse->getMultiEBCellFlagFab()); mfi.isValid(); ++mfi) {
+            if (sparse_data[0]->ok(mfi)) {
+                auto const& a = sparse_data[0]->const_array(mfi);
+                auto const& b = dense_data[0]->const_array(mfi);
+                AMREX_ALWAYS_ASSERT(a.p != nullptr && a(a.begin.x,a.begin.y,a.begin.z) ==
+                                                      b(b.begin.x,b.begin.y,b.begin.z));
+            }
+        }
+        for (int i = 0; i < static_cast<int>(dense_data.size()); ++i) {
+            const_cast<MultiCutFab*>(sparse_data[i])->decompress();
+            AMREX_ALWAYS_ASSERT(sparse_data[i]->nBytes() == dense_data[i]->nBytes());
+            compare(*dense_data[i], *sparse_data[i]);
+        }
+
+        amrex::Print() << "Sparse cut-cell data: passed\n";
+    }
+    amrex::Finalize();
+}
+
+std::unique_ptr<EBFArrayBoxFactory> make_factory (const Geometry& geom, const BoxArray& ba,
+                                                  const DistributionMapping& dm, bool sparse)
+{
+    ParmParse pp("eb2");
+    pp.add("sparse_cut_data", sparse);
+    return std::make_unique<EBFArrayBoxFactory>(EB2::IndexSpace::top().getLevel(geom), geom,
+                                                ba, dm, Vector<int>{2,2,2}, EBSupport::full);
+}
+
+Vector<MultiCutFab const*> cut_data (const EBFArrayBoxFactory& factory)
+{
+    Vector<MultiCutFab const*> r{&factory.getCentroid(), &factory.getBndryArea(),
+                                 &factory.getBndryCent(), &factory.getBndryNormal()};
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r.push_back(factory.getAreaFrac()[idim]);
+        r.push_back(factory.getFaceCent()[idim]);
+        r.push_back(factory.getEdgeCent()[idim]);
+    }
+    return r;
+}
+
+void compare (const MultiCutFab& a, const MultiCutFab& b)
+{
+    MultiFab diff = a.ToMultiFab(0.,0.);
+    MultiFab const& y = b.ToMultiFab(0.,0.);
+    MultiFab::Subtract(diff, y, 0, 0, a.nComp(), a.nGrow());
+    for (int n = 0; n < a.nComp(); ++n) {
+        AMREX_ALWAYS_ASSERT(diff.norminf(n, a.nGrow()) == 0.0);
+    }
+}
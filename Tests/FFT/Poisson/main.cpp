@@ -0,0 +1,178 @@
+#include <AMReX.H>
+#include <AMReX_FFT.H>
+#include <AMReX_FFT_Poisson.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <cmath>
+
+using namespace amrex;
+
+const Real pi = Real(3.14159265358979323846);
+
+void test_spectrum (const Box& domain, const BoxArray& ba, const DistributionMapping& dm);
+void test_roundtrip (const Box& domain, const BoxArray& ba, const DistributionMapping& dm);
+void test_poisson (const Box& domain, const BoxArray& ba, const DistributionMapping& dm,
+                   Array<LinOpBCType,AMREX_SPACEDIM> const& bc);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        Vector<int> n_cell{AMREX_D_DECL(48,40,37)};
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.queryarr("n_cell", n_cell, 0, AMREX_SPACEDIM);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(0), IntVect(AMREX_D_DECL(n_cell[0]-1,n_cell[1]-1,n_cell[2]-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        test_spectrum(domain, ba, dm);
+        test_roundtrip(domain, ba, dm);
+
+        const auto P = LinOpBCType::Periodic;
+        const auto D = LinOpBCType::Dirichlet;
+        const auto N = LinOpBCType::Neumann;
+        test_poisson(domain, ba, dm, {AMREX_D_DECL(P,P,P)});
+        test_poisson(domain, ba, dm, {AMREX_D_DECL(D,D,D)});
+        test_poisson(domain, ba, dm, {AMREX_D_DECL(N,N,N)});
+        test_poisson(domain, ba, dm, {AMREX_D_DECL(P,N,D)});
+
+        amrex::Print() << "FFT Poisson: passed\n";
+    }
+    amrex::Finalize();
+}
+
+void fill (MultiFab& mf)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            a(i,j,k) = std::sin(0.3*i+0.2) * std::cos(0.45*j) + 0.1*std::sin(0.7*k+0.3*i)
+                + 0.01*((i*7+j*13+k*5)%11);
+        });
+    }
+}
+
+// A cosine of wave number 3 in x has only the two spectral modes 3 and -3.
+void test_spectrum (const Box& domain, const BoxArray& ba, const DistributionMapping& dm)
+{
+    const int nx = domain.length(0);
+    MultiFab mf(ba, dm, 1, 0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            a(i,j,k) = std::cos(2.*pi*3*i/nx);
+        });
+    }
+    FFT::R2C r2c(domain);
+    r2c.forward(mf);
+
+    const Real npts = static_cast<Real>(domain.d_numPts());
+    Real err = 0.;
+    auto& sd = r2c.spectralData();
+    for (MFIter mfi(sd); mfi.isValid(); ++mfi) {
+        auto const& a = sd.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            bool peak = (i == 3 || i == nx-3) && j == 0 && k == 0;
+            Real expected = peak ? npts/2 : 0.;
+            err = std::max(err, std::abs(a(i,j,k).real()-expected) + std::abs(a(i,j,k).imag()));
+        });
+    }
+    ParallelDescriptor::ReduceRealMax(err);
+    amrex::Print() << "  spectrum error " << err << "\n";
+    AMREX_ALWAYS_ASSERT(err < 1.e-9*npts);
+}
+
+// The backward transform of the forward transform is the identity.
+void test_roundtrip (const Box& domain, const BoxArray& ba, const DistributionMapping& dm)
+{
+    MultiFab in(ba, dm, 1, 0);
+    MultiFab out(ba, dm, 1, 0);
+    fill(in);
+    FFT::R2C r2c(domain, {AMREX_D_DECL(FFT::Boundary::even, FFT::Boundary::periodic,
+                                       FFT::Boundary::odd)});
+    r2c.forwardThenBackward(in, out, [] (int, int, int, FFT::Complex&) {});
+    MultiFab::Subtract(out, in, 0, 0, 1, 0);
+    Real err = out.norminf(0);
+    amrex::Print() << "  round trip error " << err << "\n";
+    AMREX_ALWAYS_ASSERT(err < 1.e-12);
+}
+
+// The residual of the second-order Laplacian with ghost cells filled by
+// reflection at the domain boundaries must vanish.
+void test_poisson (const Box& domain, const BoxArray& ba, const DistributionMapping& dm,
+                   Array<LinOpBCType,AMREX_SPACEDIM> const& bc)
+{
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic;
+    bool has_dirichlet = false;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        is_periodic[idim] = bc[idim] == LinOpBCType::Periodic;
+        has_dirichlet = has_dirichlet || bc[idim] == LinOpBCType::Dirichlet;
+    }
+    Geometry geom(domain, rb, 0, is_periodic);
+
+    MultiFab rhs(ba, dm, 1, 0);
+    MultiFab soln(ba, dm, 1, 1);
+    fill(rhs);
+    if (!has_dirichlet) {
+        rhs.plus(-rhs.sum(0)/static_cast<Real>(domain.d_numPts()), 0, 1);
+    }
+    soln.setVal(0.);
+
+    FFT::Poisson poisson(geom, bc, bc);
+    poisson.solve(soln, rhs);
+
+    soln.FillBoundary(geom.periodicity());
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (is_periodic[idim]) { continue; }
+        const Real sign = (bc[idim] == LinOpBCType::Dirichlet) ? -1. : 1.;
+        const IntVect e = IntVect::TheDimensionVector(idim);
+        for (MFIter mfi(soln); mfi.isValid(); ++mfi) {
+            auto const& a = soln.array(mfi);
+            const Box& vbx = mfi.validbox();
+            const Box& lo = amrex::adjCellLo(vbx, idim) & amrex::adjCellLo(domain, idim);
+            const Box& hi = amrex::adjCellHi(vbx, idim) & amrex::adjCellHi(domain, idim);
+            amrex::LoopOnCpu(lo, [&] (int i, int j, int k) noexcept
+            {
+                IntVect iv(AMREX_D_DECL(i,j,k));
+                a(iv) = sign*a(iv+e);
+            });
+            amrex::LoopOnCpu(hi, [&] (int i, int j, int k) noexcept
+            {
+                IntVect iv(AMREX_D_DECL(i,j,k));
+                a(iv) = sign*a(iv-e);
+            });
+        }
+    }
+
+    const Real* dxinv = geom.InvCellSize();
+    Real err = 0.;
+    for (MFIter mfi(soln); mfi.isValid(); ++mfi) {
+        auto const& a = soln.const_array(mfi);
+        auto const& f = rhs.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            IntVect iv(AMREX_D_DECL(i,j,k));
+            Real lap = 0.;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const IntVect e = IntVect::TheDimensionVector(idim);
+                lap += (a(iv+e) - 2.*a(iv) + a(iv-e)) * dxinv[idim]*dxinv[idim];
+            }
+            err = std::max(err, std::abs(lap - f(iv)));
+        });
+    }
+    ParallelDescriptor::ReduceRealMax(err);
+    Real rhsmax = rhs.norminf(0);
+    amrex::Print() << "  Poisson residual " << err/rhsmax << "\n";
+    AMREX_ALWAYS_ASSERT(err < 1.e-9*rhsmax);
+}
@@ -0,0 +1,116 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MLEBABecLap.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <cmath>
+#include <memory>
+
+using namespace amrex;
+
+std::unique_ptr<EBFArrayBoxFactory> make_factory (const Geometry& geom, const BoxArray& ba,
+                                                  const DistributionMapping& dm, bool sparse);
+Long cut_bytes (const EBFArrayBoxFactory& factory);
+void solve (MultiFab& phi, const Geometry& geom, const EBFArrayBoxFactory& factory);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, is_periodic);
+        BoxArray ba(geom.Domain());
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        EB2::Build(geom, 0, 30);
+
+        auto dense = make_factory(geom, ba, dm, false);
+        auto sparse = make_factory(geom, ba, dm, true);
+
+        const Long dense_bytes = cut_bytes(*dense);
+        const Long sparse_bytes = cut_bytes(*sparse);
+
+        MultiFab phi_dense(ba, dm, 1, 1, MFInfo(), *dense);
+        MultiFab phi_sparse(ba, dm, 1, 1, MFInfo(), *sparse);
+        solve(phi_dense, geom, *dense);
+        solve(phi_sparse, geom, *sparse);
+
+        // The EB operators read the cut-cell data through const_array, so
+        // the boxes they touch go back to dense storage.
+        const Long solved_bytes = cut_bytes(*sparse);
+        amrex::Print() << "  cut-cell data: dense " << dense_bytes << " bytes, sparse "
+                       << sparse_bytes << " bytes before and " << solved_bytes
+                       << " bytes after the solve ("
+                       << static_cast<double>(solved_bytes)/static_cast<double>(dense_bytes)
+                       << ")\n";
+        AMREX_ALWAYS_ASSERT(sparse_bytes < dense_bytes && solved_bytes <= dense_bytes);
+
+        // The solution does not depend on the storage.
+        MultiFab::Subtract(phi_dense, phi_sparse, 0, 0, 1, 0);
+        AMREX_ALWAYS_ASSERT(phi_dense.norminf(0) == 0.0);
+
+        amrex::Print() << "Sparse cut-cell data with MLEBABecLap: passed\n";
+    }
+    amrex::Finalize();
+}
+
+std::unique_ptr<EBFArrayBoxFactory> make_factory (const Geometry& geom, const BoxArray& ba,
+                                                  const DistributionMapping& dm, bool sparse)
+{
+    ParmParse pp("eb2");
+    pp.add("sparse_cut_data", sparse);
+    return std::make_unique<EBFArrayBoxFactory>(EB2::IndexSpace::top().getLevel(geom), geom,
+                                                ba, dm, Vector<int>{2,2,2}, EBSupport::full);
+}
+
+Long cut_bytes (const EBFArrayBoxFactory& factory)
+{
+    Long r = factory.getCentroid().nBytes() + factory.getBndryArea().nBytes()
+        +    factory.getBndryCent().nBytes() + factory.getBndryNormal().nBytes();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r += factory.getAreaFrac()[idim]->nBytes() + factory.getFaceCent()[idim]->nBytes()
+            + factory.getEdgeCent()[idim]->nBytes();
+    }
+    ParallelDescriptor::ReduceLongSum(r);
+    return r;
+}
+
+// Poisson equation with phi = 0 on the domain boundary and phi = 1 on the EB.
+void solve (MultiFab& phi, const Geometry& geom, const EBFArrayBoxFactory& factory)
+{
+    MultiFab rhs(phi.boxArray(), phi.DistributionMap(), 1, 0, MFInfo(), factory);
+    rhs.setVal(1.0);
+    phi.setVal(0.0);
+
+    MLEBABecLap mleb({geom}, {phi.boxArray()}, {phi.DistributionMap()}, LPInfo(), {&factory});
+    mleb.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                   LinOpBCType::Dirichlet,
+                                   LinOpBCType::Dirichlet)},
+                     {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                   LinOpBCType::Dirichlet,
+                                   LinOpBCType::Dirichlet)});
+    mleb.setLevelBC(0, &phi);
+    mleb.setScalars(0.0, 1.0);
+    mleb.setBCoeffs(0, 1.0);
+    MultiFab phi_eb(phi.boxArray(), phi.DistributionMap(), 1, 0, MFInfo(), factory);
+    phi_eb.setVal(1.0);
+    mleb.setEBDirichlet(0, phi_eb, 1.0);
+
+    MLMG mlmg(mleb);
+    mlmg.setVerbose(0);
+    mlmg.solve({&phi}, {&rhs}, 1.e-10, 0.0);
+}
@@ -0,0 +1,122 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+void test_semantics ();
+void test_throughput ();
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    test_semantics();
+    test_throughput();
+
+    amrex::Finalize();
+}
+
+void test_semantics ()
+{
+    ParmParse pp("pp");
+
+    // The last definition wins, earlier ones are still reachable.
+    int n = 0;
+    pp.get("n", n);
+    AMREX_ALWAYS_ASSERT(n == 2);
+    pp.getkth("n", 0, n);
+    AMREX_ALWAYS_ASSERT(n == 1);
+    AMREX_ALWAYS_ASSERT(pp.countval("n") == 1);
+    AMREX_ALWAYS_ASSERT(pp.countname("n") == 2);
+
+    // The same value converted to several types, twice.
+    for (int i = 0; i < 2; ++i) {
+        double x = 0.;
+        float xf = 0.f;
+        std::string xs;
+        pp.get("x", x);
+        pp.get("x", xf);
+        pp.get("x", xs);
+        AMREX_ALWAYS_ASSERT(x == 1.5 && xf == 1.5f && xs == "1.5");
+
+        std::vector<int> v;
+        pp.getarr("v", v);
+        AMREX_ALWAYS_ASSERT(v == std::vector<int>({1,2,3}));
+        v.clear();
+        pp.getarr("v", v, 1, 2);
+        AMREX_ALWAYS_ASSERT(v.size() == 3 && v[1] == 2 && v[2] == 3);
+
+        bool b = false;
+        pp.get("b", b);
+        AMREX_ALWAYS_ASSERT(b);
+    }
+
+    // Entries added later take precedence and removing them is seen by
+    // the next query.
+    pp.add("n", 3);
+    pp.get("n", n);
+    AMREX_ALWAYS_ASSERT(n == 3);
+    AMREX_ALWAYS_ASSERT(pp.remove("n") == 3);
+    AMREX_ALWAYS_ASSERT(!pp.contains("n"));
+    pp.add("n", 4);
+    pp.get("n", n);
+    AMREX_ALWAYS_ASSERT(n == 4 && pp.countname("n") == 1);
+
+    // Unused inputs are still tracked.
+    std::vector<std::string> unused = ParmParse::getUnusedInputs("pp");
+    AMREX_ALWAYS_ASSERT(unused.size() == 1 && unused[0] == "pp.unused = 7");
+    AMREX_ALWAYS_ASSERT(pp.contains("unused"));
+    AMREX_ALWAYS_ASSERT(!ParmParse::hasUnusedInputs("pp"));
+
+    amrex::Print() << "ParmParse semantics: passed\n";
+}
+
+void test_throughput ()
+{
+    int nentries = 4000;
+    int nqueries = 200000;
+    {
+        ParmParse pp("bench");
+        pp.query("nentries", nentries);
+        pp.query("nqueries", nqueries);
+    }
+
+    // A deck with many entries, e.g., per species chemistry data.
+    Vector<std::string> names(nentries);
+    {
+        ParmParse pp("chem");
+        for (int i = 0; i < nentries; ++i) {
+            names[i] = "species" + std::to_string(i);
+            pp.add((names[i]+".mw").c_str(), 1.0+i);
+            pp.addarr((names[i]+".coef").c_str(), std::vector<double>{1.0*i, 2.0*i, 3.0*i});
+        }
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    ParmParse pp("chem");
+    double sum = 0.;
+    std::vector<double> coef;
+    unsigned int k = 0;
+    for (int q = 0; q < nqueries; ++q) {
+        k = k*1664525u + 1013904223u;
+        const std::string& name = names[k % nentries];
+        if (q % 2 == 0) {
+            double mw;
+            pp.get((name+".mw").c_str(), mw);
+            sum += mw;
+        } else {
+            pp.getarr((name+".coef").c_str(), coef);
+            sum += coef[2];
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double dt = std::chrono::duration<double>(t1-t0).count();
+
+    amrex::Print() << "ParmParse throughput: " << 2*nentries << " entries, "
+                   << nqueries << " queries in " << dt << " s, "
+                   << nqueries/dt << " queries/s (checksum " << sum << ")\n";
+}
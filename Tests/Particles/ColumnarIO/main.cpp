@@ -0,0 +1,150 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+
+using namespace amrex;
+
+using PC = ParticleContainer<1, 1, 2, 1>;
+
+struct Sums
+{
+    Long np = 0;
+    Real pos = 0.;
+    Real sdata = 0.;
+    Real real0 = 0.;
+    Real real1 = 0.;
+    Long int0 = 0;
+};
+
+template <class Keep>
+Sums getSums (PC& pc, Keep&& keep)
+{
+    Sums s;
+    for (int lev = 0; lev <= pc.finestLevel(); ++lev)
+    {
+        for (PC::ParIterType pti(pc, lev); pti.isValid(); ++pti)
+        {
+            const auto& aos = pti.GetArrayOfStructs();
+            const auto& r0 = pti.GetStructOfArrays().GetRealData(0);
+            const auto& r1 = pti.GetStructOfArrays().GetRealData(1);
+            const auto& i0 = pti.GetStructOfArrays().GetIntData(0);
+            for (int i = 0; i < pti.numParticles(); ++i)
+            {
+                const auto& p = aos[i];
+                if (!keep(p)) continue;
+                ++s.np;
+                s.pos += AMREX_D_TERM(p.pos(0), + 2*p.pos(1), + 3*p.pos(2));
+                s.sdata += p.rdata(0) + p.idata(0);
+                s.real0 += r0[i];
+                s.real1 += r1[i];
+                s.int0 += i0[i];
+            }
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(s.np);
+    ParallelDescriptor::ReduceLongSum(s.int0);
+    ParallelDescriptor::ReduceRealSum(s.pos);
+    ParallelDescriptor::ReduceRealSum(s.sdata);
+    ParallelDescriptor::ReduceRealSum(s.real0);
+    ParallelDescriptor::ReduceRealSum(s.real1);
+    return s;
+}
+
+bool almostEqual (Real a, Real b)
+{
+    return std::abs(a-b) <= 1.e-10*std::max(Real(1.), std::abs(a));
+}
+
+void testColumnarIO ()
+{
+    ParmParse pp("columnar");
+    IntVect size;
+    pp.get("size", size);
+    int max_grid_size = 8;
+    pp.query("max_grid_size", max_grid_size);
+    Long nparticles = 20000;
+    pp.query("nparticles", nparticles);
+
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+    const Box domain(IntVect(AMREX_D_DECL(0,0,0)), size-1);
+    Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    DistributionMapping dm(ba);
+
+    PC pc(geom, dm, ba);
+    PC::ParticleInitData pdata = {{1.0}, {2}, {3.0, 4.0}, {5}};
+    pc.InitRandom(nparticles, 1234, pdata);
+
+    // make the attributes differ from particle to particle
+    for (PC::ParIterType pti(pc, 0); pti.isValid(); ++pti)
+    {
+        auto& aos = pti.GetArrayOfStructs();
+        auto& r0 = pti.GetStructOfArrays().GetRealData(0);
+        auto& r1 = pti.GetStructOfArrays().GetRealData(1);
+        auto& i0 = pti.GetStructOfArrays().GetIntData(0);
+        for (int i = 0; i < pti.numParticles(); ++i)
+        {
+            auto& p = aos[i];
+            p.rdata(0) = p.pos(0)*p.pos(1);
+            r0[i] = p.pos(0) + 1.;
+            r1[i] = p.pos(1) - 1.;
+            i0[i] = static_cast<int>(p.id() % 7);
+        }
+    }
+
+    pc.CheckpointColumnar("chk_columnar", "particles", {"a", "b"}, {"c"});
+
+    auto all = [] (PC::ParticleType const&) { return true; };
+    const Sums ref = getSums(pc, all);
+
+    // everything
+    {
+        PC pc2(geom, dm, ba);
+        pc2.RestartColumnar("chk_columnar", "particles");
+        const Sums s = getSums(pc2, all);
+        AMREX_ALWAYS_ASSERT(s.np == ref.np && s.np == nparticles);
+        AMREX_ALWAYS_ASSERT(almostEqual(s.pos, ref.pos) && almostEqual(s.sdata, ref.sdata));
+        AMREX_ALWAYS_ASSERT(almostEqual(s.real0, ref.real0) && almostEqual(s.real1, ref.real1));
+        AMREX_ALWAYS_ASSERT(s.int0 == ref.int0);
+    }
+
+    // one real column and a region, on a different BoxArray
+    {
+        RealBox region({AMREX_D_DECL(0.1,0.2,0.3)}, {AMREX_D_DECL(0.6,0.5,0.9)});
+        auto in_region = [=] (PC::ParticleType const& p)
+        {
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                if (p.pos(d) < region.lo(d) || p.pos(d) >= region.hi(d)) return false;
+            }
+            return true;
+        };
+        const Sums ref_region = getSums(pc, in_region);
+
+        BoxArray ba2(domain);
+        ba2.maxSize(max_grid_size*2);
+        DistributionMapping dm2(ba2);
+        PC pc2(geom, dm2, ba2);
+        pc2.RestartColumnar("chk_columnar", "particles", {0, 1}, {0}, region);
+        const Sums s = getSums(pc2, all);
+        AMREX_ALWAYS_ASSERT(s.np == ref_region.np && s.np > 0);
+        AMREX_ALWAYS_ASSERT(almostEqual(s.pos, ref_region.pos) && almostEqual(s.sdata, ref_region.sdata));
+        AMREX_ALWAYS_ASSERT(s.real0 == 0. && almostEqual(s.real1, ref_region.real1) && s.int0 == 0);
+    }
+
+    amrex::Print() << "pass \n";
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    testColumnarIO();
+    amrex::Finalize();
+}
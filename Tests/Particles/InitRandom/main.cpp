@@ -0,0 +1,102 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+
+#include <cmath>
+#include <limits>
+
+using namespace amrex;
+
+using MyParticleContainer = ParticleContainer<1, 0, 1, 0>;
+
+void check (MyParticleContainer& pc, Long icount, ULong iseed, bool serialize);
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        int icount = 10000;
+        int iseed = 451;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("icount", icount);
+            pp.query("iseed", iseed);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, 0, is_periodic);
+        BoxArray ba(geom.Domain());
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        for (bool serialize : {true, false}) {
+            MyParticleContainer pc(geom, dm, ba);
+            check(pc, icount, iseed, serialize);
+        }
+
+        amrex::Print() << "InitRandom: passed\n";
+    }
+    amrex::Finalize();
+}
+
+// The particles depend only on icount and iseed, not on the number of
+// processes.  Particle j has the id first_id+j and its position comes from
+// RandomPhilox(iseed, j).
+void check (MyParticleContainer& pc, Long icount, ULong iseed, bool serialize)
+{
+    MyParticleContainer::ParticleInitData pdata = {{2.0}, {}, {3.0}, {}};
+    pc.InitRandom(icount, iseed, pdata, serialize);
+    AMREX_ALWAYS_ASSERT(pc.TotalNumberOfParticles() == icount);
+
+    Long first_id = std::numeric_limits<Long>::max();
+    for (MyParticleContainer::ParIterType pti(pc, 0); pti.isValid(); ++pti) {
+        for (auto const& p : pti.GetArrayOfStructs()) {
+            first_id = std::min(first_id, static_cast<Long>(p.id()));
+        }
+    }
+    ParallelAllReduce::Min(first_id, ParallelDescriptor::Communicator());
+
+    const Real* lo = pc.Geom(0).ProbLo();
+    const Real* hi = pc.Geom(0).ProbHi();
+    Vector<int> count(icount, 0);
+    for (MyParticleContainer::ParIterType pti(pc, 0); pti.isValid(); ++pti) {
+        auto const& soa_real = pti.GetStructOfArrays().GetRealData(0);
+        int ip = 0;
+        for (auto const& p : pti.GetArrayOfStructs()) {
+            const Long j = p.id() - first_id;
+            AMREX_ALWAYS_ASSERT(j >= 0 && j < icount);
+            ++count[j];
+
+            const auto r01 = amrex::RandomPhilox(iseed, j, 0);
+            const auto r2 = amrex::RandomPhilox(iseed, j, 1);
+            const Real r[3] = {r01[0], r01[1], r2[0]};
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                auto x = static_cast<ParticleReal>(lo[idim] + r[idim]*(hi[idim]-lo[idim]));
+                if (x >= hi[idim]) {
+                    x = std::nextafter(static_cast<ParticleReal>(hi[idim]),
+                                       static_cast<ParticleReal>(lo[idim]));
+                }
+                AMREX_ALWAYS_ASSERT(p.pos(idim) == x);
+            }
+            AMREX_ALWAYS_ASSERT(p.rdata(0) == 2.0 && soa_real[ip] == 3.0);
+            ++ip;
+        }
+    }
+
+    // Every particle is made exactly once.
+    ParallelAllReduce::Sum(count.data(), static_cast<int>(count.size()),
+                           ParallelDescriptor::Communicator());
+    for (Long j = 0; j < icount; ++j) {
+        AMREX_ALWAYS_ASSERT(count[j] == 1);
+    }
+
+    amrex::Print() << "  serialize = " << serialize << ": " << icount
+                   << " particles with ids from " << first_id << "\n";
+}
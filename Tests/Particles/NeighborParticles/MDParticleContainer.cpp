@@ -318,7 +318,7 @@ void MDParticleContainer::checkNeighborParticles()
 #endif
 }
 
-void MDParticleContainer::checkNeighborList()
+void MDParticleContainer::checkNeighborList(bool half)
 {
     BL_PROFILE("MDParticleContainer::checkNeighborList");
 
@@ -364,6 +364,9 @@ void MDParticleContainer::checkNeighborList()
                 // Don't be your own neighbor.
                 if ( i == j ) continue;
 
+                // A half list only has the pairs with j > i.
+                if ( half && j < i ) continue;
+
                 ParticleType& p2 = pstruct[j];
                 Real dx = p1.pos(0) - p2.pos(0);
                 Real dy = p1.pos(1) - p2.pos(1);
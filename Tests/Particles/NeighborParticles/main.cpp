@@ -183,4 +183,33 @@ void testNeighborList ()
     pc.buildNeighborList(CheckPair());
 
     pc.checkNeighborList();
+
+    pc.setHalfNeighborList(true);
+    pc.buildNeighborList(CheckPair());
+
+    pc.checkNeighborList(true);
+
+    // A Verlet list only needs to be rebuilt after a particle has moved
+    // more than half of the skin.
+    pc.setHalfNeighborList(false);
+    pc.setNeighborListSkin(0.1);
+    pc.buildNeighborList(CheckPair());
+
+    if (pc.neighborListNeedsRebuild()) {
+        amrex::Abort("Verlet list should not need a rebuild right after it was built");
+    }
+
+    pc.moveParticles(0.01);
+    pc.updateNeighbors();
+    if (pc.neighborListNeedsRebuild()) {
+        amrex::Abort("Verlet list should not need a rebuild after moving less than half the skin");
+    }
+
+    pc.moveParticles(0.03);
+    pc.updateNeighbors();
+    if (!pc.neighborListNeedsRebuild()) {
+        amrex::Abort("Verlet list should need a rebuild after moving more than half the skin");
+    }
+
+    amrex::PrintToFile("neighbor_test") << "Verlet list rebuild checks passed" << std::endl;
 }
@@ -38,6 +38,7 @@ int main_main()
     std::string zone_info_var_name;
     Vector<std::string> plot_names(1);
     bool abort_if_not_all_found = false;
+    int nahead = 2;
 
     int farg = 1;
     while (farg <= narg) {
@@ -62,6 +63,8 @@ int main_main()
             atol = std::stod(amrex::get_command_argument(++farg));
         } else if (fname == "--abort_if_not_all_found") {
             abort_if_not_all_found = true;
+        } else if (fname == "--read_ahead") {
+            nahead = std::stoi(amrex::get_command_argument(++farg));
         } else {
             break;
         }
@@ -83,7 +86,7 @@ int main_main()
             << " variable.\n"
             << "\n"
             << " usage:\n"
-            << "    fcompare [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [--abs_tol] file1 file2\n"
+            << "    fcompare [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [--abs_tol] [--read_ahead] file1 file2\n"
             << "\n"
             << " optional arguments:\n"
             << "    -n|--norm num         : what norm to use (default is 0 for inf norm)\n"
@@ -94,6 +97,8 @@ int main_main()
             << "    -a|--allow_diff_grids : allow different BoxArrays covering the same domain\n"
             << "    -r|--rel_tol rtol     : relative tolerance (default is 0)\n"
             << "    --abs_tol atol        : absolute tolerance (default is 0)\n"
+            << "    --read_ahead n        : number of grids read ahead of the comparison\n"
+            << "                            (default is 2)\n"
             << std::endl;
         return 0;
     }
@@ -204,33 +209,157 @@ int main_main()
         Vector<Real> rerror_denom(ncomp_a, 0.0);
         Vector<int> has_nan_a(ncomp_a, false);
         Vector<int> has_nan_b(ncomp_a, false);
+
+        // max, sum and sum of squares of |B-A| and of |A| for each variable
+        Vector<Real> dmax(ncomp_a, 0.0), dsum(ncomp_a, 0.0), dsum2(ncomp_a, 0.0);
+        Vector<Real> amax(ncomp_a, 0.0), asum(ncomp_a, 0.0), asum2(ncomp_a, 0.0);
+        Real zone_max = -1.0;
+        Long zone_pos = 0;
+        int zone_gid = -1;
+        IntVect zone_cell;
+
+        const BoxArray& ba_a = pf_a.boxArray(ilev);
+        const BoxArray& ba_b = pf_b.boxArray(ilev);
+        const DistributionMapping& dmap = pf_a.DistributionMap(ilev);
+        Vector<int> gids;
+        for (int i = 0; i < ba_a.size(); ++i) {
+            if (dmap[i] == ParallelDescriptor::MyProc()) { gids.push_back(i); }
+        }
+
+        // Stream the grids one at a time with all the variables, reading
+        // the next ones in the background, so that only a few grids are
+        // in memory.
+        const int nbuf = std::max(nahead,0) + 1;
+        Vector<std::unique_ptr<FArrayBox> > buf_a(nbuf), buf_b(nbuf);
+
+        ReadAhead(static_cast<int>(gids.size()), nahead,
+        [&] (int i)
+        {
+            const int gid = gids[i];
+            buf_a[i%nbuf] = pf_a.getFab(ilev, gid);
+            if (grids_match) {
+                buf_b[i%nbuf] = pf_b.getFab(ilev, gid);
+            } else {
+                const Box& bx = ba_a[gid];
+                buf_b[i%nbuf] = std::make_unique<FArrayBox>(bx, ncomp_b);
+                buf_b[i%nbuf]->setVal<RunOn::Host>(0.0);
+                for (auto const& is : ba_b.intersections(bx)) {
+                    std::unique_ptr<FArrayBox> fab = pf_b.getFab(ilev, is.first);
+                    buf_b[i%nbuf]->copy<RunOn::Host>(*fab, is.second, 0, is.second, 0, ncomp_b);
+                }
+            }
+        },
+        [&] (int i)
+        {
+            const int gid = gids[i];
+            std::unique_ptr<FArrayBox> fab_a = std::move(buf_a[i%nbuf]);
+            std::unique_ptr<FArrayBox> fab_b = std::move(buf_b[i%nbuf]);
+            const auto& a = fab_a->const_array();
+            const auto& b = fab_b->const_array();
+            Array4<Real> diff;
+            if (save_var_a >= 0) {
+                diff = mf_array[ilev][gid].array();
+            }
+
+            const Box& bx = ba_a[gid];
+            const auto lo = amrex::lbound(bx);
+            const auto hi = amrex::ubound(bx);
+            const int ny = hi.y-lo.y+1;
+            const int npencils = ny*(hi.z-lo.z+1);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            {
+                Vector<Real> tdmax(ncomp_a, 0.0), tdsum(ncomp_a, 0.0), tdsum2(ncomp_a, 0.0);
+                Vector<Real> tamax(ncomp_a, 0.0), tasum(ncomp_a, 0.0), tasum2(ncomp_a, 0.0);
+                Vector<int> tnan_a(ncomp_a, false), tnan_b(ncomp_a, false);
+                Real tzmax = -1.0;
+                Long tzpos = std::numeric_limits<Long>::max();
+                IntVect tzcell;
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+                for (int ip = 0; ip < npencils; ++ip) {
+                    const int j = lo.y + ip%ny;
+                    const int k = lo.z + ip/ny;
+                    for (int n_a = 0; n_a < ncomp_a; ++n_a) {
+                        const int n_b = ivar_b[n_a];
+                        if (n_b < 0) { continue; }
+                        for (int ii = lo.x; ii <= hi.x; ++ii) {
+                            const Real va = a(ii,j,k,n_a);
+                            const Real vb = b(ii,j,k,n_b);
+                            if (std::isnan(va)) { tnan_a[n_a] = true; }
+                            if (std::isnan(vb)) { tnan_b[n_a] = true; }
+                            const Real d = vb - va;
+                            const Real ad = std::abs(d);
+                            tdmax[n_a] = std::max(tdmax[n_a], ad);
+                            tdsum[n_a] += ad;
+                            tdsum2[n_a] += d*d;
+                            tamax[n_a] = std::max(tamax[n_a], std::abs(va));
+                            tasum[n_a] += std::abs(va);
+                            tasum2[n_a] += va*va;
+                            if (n_a == save_var_a) {
+                                diff(ii,j,k) = ad;
+                            }
+                            if (n_a == zone_info_var_a && ad > tzmax) {
+                                tzmax = ad;
+                                tzpos = static_cast<Long>(ip)*(hi.x-lo.x+1) + (ii-lo.x);
+                                tzcell = IntVect(AMREX_D_DECL(ii,j,k));
+                            }
+                        }
+                    }
+                }
+#ifdef AMREX_USE_OMP
+#pragma omp critical (fcompare_reduce)
+#endif
+                {
+                    for (int n_a = 0; n_a < ncomp_a; ++n_a) {
+                        dmax[n_a] = std::max(dmax[n_a], tdmax[n_a]);
+                        dsum[n_a] += tdsum[n_a];
+                        dsum2[n_a] += tdsum2[n_a];
+                        amax[n_a] = std::max(amax[n_a], tamax[n_a]);
+                        asum[n_a] += tasum[n_a];
+                        asum2[n_a] += tasum2[n_a];
+                        has_nan_a[n_a] = has_nan_a[n_a] || tnan_a[n_a];
+                        has_nan_b[n_a] = has_nan_b[n_a] || tnan_b[n_a];
+                    }
+                    // the first cell of the first grid with the max error
+                    if (tzmax > zone_max ||
+                        (tzmax == zone_max && zone_gid == gid && tzpos < zone_pos)) {
+                        zone_max = tzmax;
+                        zone_pos = tzpos;
+                        zone_gid = gid;
+                        zone_cell = tzcell;
+                    }
+                }
+            }
+        });
+
+        ParallelDescriptor::ReduceRealMax(dmax.data(), ncomp_a);
+        ParallelDescriptor::ReduceRealMax(amax.data(), ncomp_a);
+        ParallelDescriptor::ReduceRealSum(dsum.data(), ncomp_a);
+        ParallelDescriptor::ReduceRealSum(dsum2.data(), ncomp_a);
+        ParallelDescriptor::ReduceRealSum(asum.data(), ncomp_a);
+        ParallelDescriptor::ReduceRealSum(asum2.data(), ncomp_a);
+        ParallelDescriptor::ReduceIntMax(has_nan_a.data(), ncomp_a);
+        ParallelDescriptor::ReduceIntMax(has_nan_b.data(), ncomp_a);
+
         for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
             if (ivar_b[icomp_a] >= 0) {
-                const MultiFab& mf_a = pf_a.get(ilev, names_a[icomp_a]);
-                MultiFab mf_b;
-                if (grids_match) {
-                    mf_b = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
-                } else {
-                    mf_b.define(mf_a.boxArray(), mf_a.DistributionMap(), 1, 0);
-                    MultiFab tmp = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
-                    mf_b.ParallelCopy(tmp);
-                }
-                has_nan_a[icomp_a] = mf_a.contains_nan();
-                has_nan_b[icomp_a] = mf_b.contains_nan();
-                MultiFab::Subtract(mf_b,mf_a,0,0,1,0); // b = b - a
-                Real max_err = mf_b.norm0();
+                const Real max_err = dmax[icomp_a];
                 if (norm == 1) {
-                    aerror[icomp_a] = mf_b.norm1();
+                    aerror[icomp_a] = dsum[icomp_a];
                     rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm1();
+                    rerror_denom[icomp_a] = asum[icomp_a];
                 } else if (norm == 2) {
-                    aerror[icomp_a] = mf_b.norm2();
+                    aerror[icomp_a] = std::sqrt(dsum2[icomp_a]);
                     rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm2();
+                    rerror_denom[icomp_a] = std::sqrt(asum2[icomp_a]);
                 } else {
                     aerror[icomp_a] = max_err;
                     rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm0();
+                    rerror_denom[icomp_a] = amax[icomp_a];
                 }
 
                 if (norm == 0) {
@@ -245,22 +374,23 @@ int main_main()
                     rerror[icomp_a] = rerror[icomp_a]/rerror_denom[icomp_a];
                 }
 
-                if (icomp_a == save_var_a || icomp_a == zone_info_var_a) {
-                    mf_b.abs(0,1);
-                }
-
-                if (icomp_a == save_var_a) {
-                    MultiFab::Copy(mf_array[ilev], mf_b, 0, 0, 1, 0);
-                }
-
                 if (icomp_a == zone_info_var_a) {
                     if (max_err > err_zone.max_abs_err) {
+                        // the lowest process that has the max error
+                        const int nprocs = ParallelDescriptor::NProcs();
+                        int owner = (zone_gid >= 0 && zone_max == max_err)
+                            ? ParallelDescriptor::MyProc() : nprocs;
+                        ParallelDescriptor::ReduceIntMin(owner);
+                        int zone_info[AMREX_SPACEDIM+1];
+                        zone_info[0] = zone_gid;
+                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                            zone_info[idim+1] = zone_cell[idim];
+                        }
+                        ParallelDescriptor::Bcast(zone_info, AMREX_SPACEDIM+1, owner);
                         err_zone.max_abs_err = max_err;
                         err_zone.level = ilev;
-                        err_zone.cell = mf_b.maxIndex(0);
-                        auto isects = pf_a.boxArray(ilev).intersections
-                            (Box(err_zone.cell,err_zone.cell), true, 0);
-                        err_zone.grid_index = isects[0].first;
+                        err_zone.grid_index = zone_info[0];
+                        err_zone.cell = IntVect(&zone_info[1]);
                     }
                 }
             }
@@ -347,10 +477,13 @@ int main_main()
                                   << "   level = " << err_zone.level << " (i,j,k) = " << err_zone.cell << "\n";
             }
 
+            std::unique_ptr<FArrayBox> fab;
+            if (owner_proc) {
+                fab = pf_a.getFab(err_zone.level, err_zone.grid_index);
+            }
             for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
-                const MultiFab& mf = pf_a.get(err_zone.level,names_a[icomp_a]);
                 if (owner_proc) {
-                    Real v = mf[err_zone.grid_index](err_zone.cell);
+                    Real v = (*fab)(err_zone.cell, icomp_a);
                     amrex::AllPrint() << " " << std::setw(24)
                                       << names_a[icomp_a] << "  "
                                       << std::setw(24) << std::right
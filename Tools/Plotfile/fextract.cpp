@@ -212,8 +212,11 @@ void main_main()
     IntVect rr{1};
     for (int ilev = coarse_level; ilev <= fine_level; ++ilev) {
         Box slice_box(ivloc*rr,ivloc*rr);
-        slice_box.setSmall(idir, std::numeric_limits<int>::lowest());
-        slice_box.setBig(idir, std::numeric_limits<int>::max());
+        slice_box.setSmall(idir, pf.probDomain(ilev).smallEnd(idir));
+        slice_box.setBig(idir, pf.probDomain(ilev).bigEnd(idir));
+
+        // Only the grids crossing the line are read.
+        const MultiFab& mf = pf.get(ilev, slice_box, var_names);
 
         Array<Real,AMREX_SPACEDIM> dx = pf.cellSize(ilev);
 
@@ -222,30 +225,26 @@ void main_main()
             for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                 ratio[idim] = 1;
             }
-            const iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
-                                                pf.boxArray(ilev+1), ratio);
+            const iMultiFab mask = makeFineMask(mf, pf.boxArray(ilev+1), ratio);
             for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
                 for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                    const Box& bx = mfi.validbox() & slice_box;
-                    if (bx.ok()) {
-                        const auto& m = mask.array(mfi);
-                        const auto& fab = mf.array(mfi);
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (m(i,j,k) == 0) { // not covered by fine
-                                        if (pos.size() == data[ivar].size()) {
-                                            Array<Real,AMREX_SPACEDIM> p
-                                                = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
-                                                                problo[1]+static_cast<Real>(j+0.5)*dx[1],
-                                                                problo[2]+static_cast<Real>(k+0.5)*dx[2])};
-                                            pos.push_back(p[idir]);
-                                        }
-                                        data[ivar].push_back(fab(i,j,k));
+                    const Box& bx = mfi.validbox();
+                    const auto& m = mask.array(mfi);
+                    const auto& fab = mf.array(mfi, ivar);
+                    const auto lo = amrex::lbound(bx);
+                    const auto hi = amrex::ubound(bx);
+                    for         (int k = lo.z; k <= hi.z; ++k) {
+                        for     (int j = lo.y; j <= hi.y; ++j) {
+                            for (int i = lo.x; i <= hi.x; ++i) {
+                                if (m(i,j,k) == 0) { // not covered by fine
+                                    if (pos.size() == data[ivar].size()) {
+                                        Array<Real,AMREX_SPACEDIM> p
+                                            = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
+                                                            problo[1]+static_cast<Real>(j+0.5)*dx[1],
+                                                            problo[2]+static_cast<Real>(k+0.5)*dx[2])};
+                                        pos.push_back(p[idir]);
                                     }
+                                    data[ivar].push_back(fab(i,j,k));
                                 }
                             }
                         }
@@ -255,25 +254,22 @@ void main_main()
             rr *= ratio;
         } else {
             for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
                 for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                    const Box& bx = mfi.validbox() & slice_box;
-                    if (bx.ok()) {
-                        const auto& fab = mf.array(mfi);
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (pos.size() == data[ivar].size()) {
-                                        Array<Real,AMREX_SPACEDIM> p
-                                            = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
-                                                            problo[1]+static_cast<Real>(j+0.5)*dx[1],
-                                                            problo[2]+static_cast<Real>(k+0.5)*dx[2])};
-                                        pos.push_back(p[idir]);
-                                    }
-                                    data[ivar].push_back(fab(i,j,k));
+                    const Box& bx = mfi.validbox();
+                    const auto& fab = mf.array(mfi, ivar);
+                    const auto lo = amrex::lbound(bx);
+                    const auto hi = amrex::ubound(bx);
+                    for         (int k = lo.z; k <= hi.z; ++k) {
+                        for     (int j = lo.y; j <= hi.y; ++j) {
+                            for (int i = lo.x; i <= hi.x; ++i) {
+                                if (pos.size() == data[ivar].size()) {
+                                    Array<Real,AMREX_SPACEDIM> p
+                                        = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
+                                                        problo[1]+static_cast<Real>(j+0.5)*dx[1],
+                                                        problo[2]+static_cast<Real>(k+0.5)*dx[2])};
+                                    pos.push_back(p[idir]);
                                 }
+                                data[ivar].push_back(fab(i,j,k));
                             }
                         }
                     }
@@ -16,12 +16,15 @@ void main_main()
     const int narg = amrex::command_argument_count();
 
     std::string varnames_arg;
+    int nahead = 2;
 
     int farg = 1;
     while (farg <= narg) {
         const std::string& name = amrex::get_command_argument(farg);
         if (name == "-v" || name == "--variable") {
             varnames_arg = amrex::get_command_argument(++farg);
+        } else if (name == "--read_ahead") {
+            nahead = std::stoi(amrex::get_command_argument(++farg));
         } else {
             break;
         }
@@ -32,10 +35,11 @@ void main_main()
         amrex::Print() << "\n"
                        << " Report the extrema (min/max) for each variable in a plotfile\n"
                        << " usage: \n"
-                       << "    fextrema {[-v|--variable] name} plotfiles\n"
+                       << "    fextrema {[-v|--variable] name} [--read_ahead n] plotfiles\n"
                        << "\n"
                        << "   -v names    : output information only for specified variables, given\n"
                        << "                 as a space-spearated string\n"
+                       << "   --read_ahead n : number of grids read ahead of the computation (default 2)\n"
                        << std::endl;
         return;
     }
@@ -58,47 +62,100 @@ void main_main()
             }
         }
 
+        const int nvars = var_names.size();
+        Vector<int> icomp(nvars);
+        for (int ivar = 0; ivar < nvars; ++ivar) {
+            auto r = std::find(var_names_pf.begin(), var_names_pf.end(), var_names[ivar]);
+            if (r == var_names_pf.end()) {
+                amrex::Abort("fextrema: varname not found "+var_names[ivar]);
+            }
+            icomp[ivar] = static_cast<int>(std::distance(var_names_pf.begin(), r));
+        }
+
         // get the extrema
-        Vector<Real> vvmin(var_names.size());
-        Vector<Real> vvmax(var_names.size());
+        Vector<Real> vvmin(nvars, std::numeric_limits<Real>::max());
+        Vector<Real> vvmax(nvars, std::numeric_limits<Real>::lowest());
 
         const int dim = pf.spaceDim();
+        const int myproc = ParallelDescriptor::MyProc();
+
+        // Stream the grids one at a time with all the variables, reading
+        // the next ones in the background, so that only a few grids are
+        // in memory.
+        const int nbuf = std::max(nahead,0) + 1;
+        Vector<std::unique_ptr<FArrayBox> > buf(nbuf);
 
         for (int ilev = pf.finestLevel(); ilev >= 0; --ilev) {
-            if (ilev == pf.finestLevel()) {
-                for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                    const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                    vvmin[ivar] = mf.min(0,0,false);
-                    vvmax[ivar] = mf.max(0,0,false);
-                }
-            } else {
+            const BoxArray& ba = pf.boxArray(ilev);
+            const DistributionMapping& dmap = pf.DistributionMap(ilev);
+            Vector<int> gids;
+            for (int i = 0; i < ba.size(); ++i) {
+                if (dmap[i] == myproc) { gids.push_back(i); }
+            }
+
+            BoxArray cfba;
+            if (ilev < pf.finestLevel()) {
                 IntVect ratio{pf.refRatio(ilev)};
                 for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                     ratio[idim] = 1;
                 }
-                iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
-                                              pf.boxArray(ilev+1), ratio);
-                for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                    const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                        const Box& bx = mfi.validbox();
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        const auto& ifab = mask.array(mfi);
-                        const auto& fab = mf.array(mfi);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (ifab(i,j,k) == 0) {
-                                        vvmin[ivar] = std::min(fab(i,j,k),vvmin[ivar]);
-                                        vvmax[ivar] = std::max(fab(i,j,k),vvmax[ivar]);
-                                    }
+                cfba = amrex::coarsen(pf.boxArray(ilev+1), ratio);
+            }
+
+            ReadAhead(static_cast<int>(gids.size()), nahead,
+            [&] (int i) { buf[i%nbuf] = pf.getFab(ilev, gids[i]); },
+            [&] (int i)
+            {
+                std::unique_ptr<FArrayBox> fab = std::move(buf[i%nbuf]);
+                const Box& bx = ba[gids[i]];
+
+                // 1 where covered by the next finer level
+                IArrayBox mask(bx);
+                mask.setVal<RunOn::Host>(0);
+                if (!cfba.empty()) {
+                    for (auto const& is : cfba.intersections(bx)) {
+                        mask.setVal<RunOn::Host>(1, is.second);
+                    }
+                }
+
+                const auto& ifab = mask.const_array();
+                const auto& a = fab->const_array();
+                const auto lo = amrex::lbound(bx);
+                const auto hi = amrex::ubound(bx);
+                const int ny = hi.y-lo.y+1;
+                const int npencils = ny*(hi.z-lo.z+1);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+                {
+                    Vector<Real> tmin(nvars, std::numeric_limits<Real>::max());
+                    Vector<Real> tmax(nvars, std::numeric_limits<Real>::lowest());
+#ifdef AMREX_USE_OMP
+#pragma omp for
+#endif
+                    for (int ip = 0; ip < npencils; ++ip) {
+                        const int j = lo.y + ip%ny;
+                        const int k = lo.z + ip/ny;
+                        for (int ivar = 0; ivar < nvars; ++ivar) {
+                            const int n = icomp[ivar];
+                            for (int ii = lo.x; ii <= hi.x; ++ii) {
+                                if (ifab(ii,j,k) == 0) {
+                                    tmin[ivar] = std::min(a(ii,j,k,n),tmin[ivar]);
+                                    tmax[ivar] = std::max(a(ii,j,k,n),tmax[ivar]);
                                 }
                             }
                         }
                     }
+#ifdef AMREX_USE_OMP
+#pragma omp critical (fextrema_reduce)
+#endif
+                    for (int ivar = 0; ivar < nvars; ++ivar) {
+                        vvmin[ivar] = std::min(tmin[ivar],vvmin[ivar]);
+                        vvmax[ivar] = std::max(tmax[ivar],vvmax[ivar]);
+                    }
                 }
-            }
+            });
         }
 
         ParallelDescriptor::ReduceRealMin(vvmin.data(), vvmin.size());